@@ -0,0 +1,66 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory_resource>
+
+// Short-lived arrays: each "request" builds a few thousand small circular dynamic arrays, with storage from the global heap, a
+// MonotonicArena that is reset after every request, or a std::pmr::monotonic_buffer_resource.
+// Large arrays: random reads over 256 MiB of ints with std::allocator and HugePageAllocator storage.
+
+long long sink = 0;
+
+template <typename Alloc, typename MakeAlloc, typename Reset> double perRequest(int requests, MakeAlloc makeAlloc, Reset reset) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < requests; r++) {
+        for (int a = 0; a < 2000; a++) {
+            CircularDynamicArray<int, ModuloCapacity, Alloc> cda(makeAlloc());
+            for (int i = 0; i < 40; i++) {
+                cda.addEnd(i + a);
+            }
+            sink += cda[a % 40];
+        }
+        reset();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(finish - begin).count() / requests;
+}
+
+template <typename Alloc> double randomReads(int n, int reads) {
+    CircularDynamicArray<int, PowerOfTwoCapacity, Alloc> cda;
+    for (int i = 0; i < n; i++) {
+        cda.addEnd(i);
+    }
+    unsigned x = 1;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < reads; i++) {
+        x = x * 1664525u + 1013904223u;
+        sink += cda[(int)(x % (unsigned)n)];
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - begin).count() / reads;
+}
+
+int main() {
+    const int requests = 200;
+
+    MonotonicArena arena;
+    std::pmr::monotonic_buffer_resource resource;
+    std::cout << "short-lived arrays (us/request)" << std::endl;
+    std::cout << "std::allocator\t" << perRequest<std::allocator<int>>(requests, [] { return std::allocator<int>(); }, [] {}) << std::endl;
+    std::cout << "ArenaAllocator\t"
+              << perRequest<ArenaAllocator<int>>(requests, [&] { return ArenaAllocator<int>(arena); }, [&] { arena.reset(); }) << std::endl;
+    std::cout << "std::pmr\t"
+              << perRequest<std::pmr::polymorphic_allocator<int>>(
+                     requests, [&] { return std::pmr::polymorphic_allocator<int>(&resource); }, [&] { resource.release(); })
+              << std::endl;
+
+    const int n = 1 << 26;
+    const int reads = 20000000;
+    std::cout << "random reads over " << n << " ints (ns/read)" << std::endl;
+    std::cout << "std::allocator\t" << randomReads<std::allocator<int>>(n, reads) << std::endl;
+    std::cout << "HugePageAllocator\t" << randomReads<HugePageAllocator<int>>(n, reads) << std::endl;
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
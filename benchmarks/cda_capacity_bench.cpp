@@ -0,0 +1,62 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+
+// Compares the ModuloCapacity and PowerOfTwoCapacity policies of the circular dynamic array
+// on queue churn (addEnd + delFront) and on random access through operator[].
+
+template <typename capPolicy> double queueChurn(int n, int rounds, long long &sink) {
+    CircularDynamicArray<int, capPolicy> cda;
+    for (int i = 0; i < n; i++) {
+        cda.addEnd(i);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < n; i++) {
+            sink += cda[0];
+            cda.delFront();
+            cda.addEnd(i);
+        }
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(finish - begin).count() / ((double)n * rounds);
+}
+
+template <typename capPolicy> double randomAccess(int n, int rounds, long long &sink) {
+    CircularDynamicArray<int, capPolicy> cda;
+    for (int i = 0; i < n; i++) {
+        cda.addFront(i);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        unsigned idx = r;
+        for (int i = 0; i < n; i++) {
+            idx = idx * 1664525u + 1013904223u;
+            sink += cda[idx % n];
+        }
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(finish - begin).count() / ((double)n * rounds);
+}
+
+int main() {
+    long long sink = 0;
+    const int sizes[] = {1000, 100000, 3000000};
+
+    std::cout << "size\tchurn modulo\tchurn pow2\taccess modulo\taccess pow2 (ns/op)" << std::endl;
+    for (int n : sizes) {
+        int rounds = 30000000 / n;
+        std::cout << n << "\t" << queueChurn<ModuloCapacity>(n, rounds, sink)
+                  << "\t" << queueChurn<PowerOfTwoCapacity>(n, rounds, sink)
+                  << "\t" << randomAccess<ModuloCapacity>(n, rounds, sink)
+                  << "\t" << randomAccess<PowerOfTwoCapacity>(n, rounds, sink) << std::endl;
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
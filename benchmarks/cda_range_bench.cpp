@@ -0,0 +1,51 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Compares loading a circular dynamic array one addEnd at a time against a single appendRange call.
+
+template <typename F> double timeMs(F f) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(finish - begin).count();
+}
+
+int main() {
+    long long sink = 0;
+    const int sizes[] = {1000, 1000000, 20000000};
+
+    std::cout << "size\taddEnd loop\tappendRange\tprependRange (ms)" << std::endl;
+    for (int n : sizes) {
+        std::vector<int> src(n);
+        for (int i = 0; i < n; i++) {
+            src[i] = i;
+        }
+
+        double loop = timeMs([&] {
+            CircularDynamicArray<int> cda;
+            for (int i = 0; i < n; i++) {
+                cda.addEnd(src[i]);
+            }
+            sink += cda[n - 1];
+        });
+        double append = timeMs([&] {
+            CircularDynamicArray<int> cda;
+            cda.appendRange(src);
+            sink += cda[n - 1];
+        });
+        double prepend = timeMs([&] {
+            CircularDynamicArray<int> cda;
+            cda.addEnd(-1);
+            cda.prependRange(src);
+            sink += cda[n - 1];
+        });
+
+        std::cout << n << "\t" << loop << "\t" << append << "\t" << prepend << std::endl;
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,64 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+// Compares the vectorized linearSearch, count and findAll against an operator[] loop, and the SSE2 and AVX2 kernels against
+// the scalar kernel, on int, float and int8_t arrays. The searched value only appears at the end of the array.
+
+template <typename F> double timeUs(F f, int reps) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; r++) {
+        f();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(finish - begin).count() / reps;
+}
+
+long long sink = 0;
+
+template <typename T> void benchType(const char *name, int n, int reps) {
+    CircularDynamicArray<T> cda;
+    for (int i = 0; i < n; i++) {
+        cda.addFront((T)(i % 100 + 1));
+    }
+    cda[n - 1] = (T)0;
+    T needle = 0;
+
+    double loop = timeUs([&] {
+        for (int i = 0; i < cda.length(); i++) {
+            if (cda[i] == needle) {
+                sink += i;
+                break;
+            }
+        }
+    }, reps);
+    double search = timeUs([&] { sink += cda.linearSearch(needle); }, reps);
+    double count = timeUs([&] { sink += cda.count(needle); }, reps);
+    double all = timeUs([&] { sink += cda.findAll(needle).size(); }, reps);
+
+    auto [head, tail] = cda.segments();
+    double scalar = timeUs([&] { sink += SimdSearch::scanScalar(head.data(), (int)head.size(), needle, SimdSearch::count, nullptr, 0, 0); }, reps);
+    double sse2 = scalar, avx2 = scalar;
+#if DATASTRUCTS_X86_SIMD
+    sse2 = timeUs([&] { sink += SimdSearch::scanSSE2(head.data(), (int)head.size(), needle, SimdSearch::count, nullptr, 0); }, reps);
+    if (__builtin_cpu_supports("avx2")) {
+        avx2 = timeUs([&] { sink += SimdSearch::scanAVX2(head.data(), (int)head.size(), needle, SimdSearch::count, nullptr, 0); }, reps);
+    }
+#endif
+
+    std::cout << name << "\t" << loop << "\t" << search << "\t" << count << "\t" << all << "\t" << scalar << "\t" << sse2 << "\t" << avx2 << std::endl;
+}
+
+int main() {
+    const int n = 4000000, reps = 20;
+    std::cout << n << " elements, microseconds per call" << std::endl;
+    std::cout << "type\toperator[] loop\tlinearSearch\tcount\tfindAll\tscalar count\tSSE2 count\tAVX2 count" << std::endl;
+    benchType<int>("int", n, reps);
+    benchType<float>("float", n, reps);
+    benchType<std::int8_t>("int8_t", n, reps);
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+#include "../datastructs.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Compares lookups in a sorted array of ints: std::lower_bound on a vector, the branchless CircularDynamicArray::lowerBound and
+// EytzingerIndex::lowerBound. Queries are uniformly random, so large sizes are dominated by cache misses.
+// The largest size can be lowered with the first argument, e.g. ./cda_search_index_bench 1000000
+
+long long sink = 0;
+
+template <typename Search> double perQuery(int n, int queries, Search search) {
+    unsigned x = 12345;
+    auto begin = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        x = x * 1664525u + 1013904223u;
+        sink += search((int)(x % (2u * (unsigned)n)));
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - begin).count() / queries;
+}
+
+int main(int argc, char **argv) {
+    int maxSize = argc > 1 ? std::atoi(argv[1]) : 100000000;
+    const int queries = 2000000;
+
+    std::cout << "size\tstd::lower_bound\tCDA lowerBound\tEytzinger (ns/query)" << std::endl;
+    for (int n : {1000, 1000000, 100000000}) {
+        if (n > maxSize) {
+            break;
+        }
+        std::vector<int> sorted(n);
+        for (int i = 0; i < n; i++) {
+            sorted[i] = 2 * i;
+        }
+        CircularDynamicArray<int> cda;
+        cda.appendRange(std::span<const int>(sorted));
+        EytzingerIndex<int> index(cda);
+
+        double stdTime = perQuery(n, queries, [&](int e) {
+            return (int)(std::lower_bound(sorted.begin(), sorted.end(), e) - sorted.begin());
+        });
+        double cdaTime = perQuery(n, queries, [&](int e) { return cda.lowerBound(e); });
+        double eytzingerTime = perQuery(n, queries, [&](int e) { return index.lowerBound(e); });
+
+        std::cout << n << "\t" << stdTime << "\t" << cdaTime << "\t" << eytzingerTime << std::endl;
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
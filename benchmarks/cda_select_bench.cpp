@@ -0,0 +1,75 @@
+#include "../datastructs.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Times QuickSelect and WCSelect (on a copy and in place) for the median of random ints against std::nth_element,
+// p50/p90/p99/p999 through four QuickSelect calls against one selectMany call, and topK against std::partial_sort.
+// The largest size can be given as the first argument, e.g. 100000000.
+
+template <typename F> double timeMs(F f) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(finish - begin).count();
+}
+
+int main(int argc, char **argv) {
+    int maxSize = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    std::mt19937 gen(7);
+
+    std::cout << "size\tQuickSelect\tWCSelect\tQuickSelect in place\tstd::nth_element (ms)" << std::endl;
+    for (int n = 1000000; n <= maxSize; n *= 10) {
+        std::vector<int> src(n);
+        for (int &v : src) {
+            v = (int)gen();
+        }
+        CircularDynamicArray<int> cda;
+        cda.appendRange(src);
+        int k = n / 2;
+        int quick = 0, wc = 0, inPlace = 0;
+
+        double q = timeMs([&] { quick = cda.QuickSelect(k); });
+        double w = timeMs([&] { wc = cda.WCSelect(k); });
+        double p = timeMs([&] { inPlace = cda.QuickSelect(k, true); });
+        double v = timeMs([&] { std::nth_element(src.begin(), src.begin() + (k - 1), src.end()); });
+
+        if (quick != src[k - 1] || wc != src[k - 1] || inPlace != src[k - 1]) {
+            std::cerr << "select mismatch" << std::endl;
+            return 1;
+        }
+        std::cout << n << "\t" << q << "\t" << w << "\t" << p << "\t" << v << std::endl;
+    }
+
+    std::cout << std::endl << "size\t4x QuickSelect\tselectMany(4)\ttopK(1000)\tstd::partial_sort(1000) (ms)" << std::endl;
+    for (int n = 1000000; n <= maxSize; n *= 10) {
+        std::vector<int> src(n);
+        for (int &v : src) {
+            v = (int)gen();
+        }
+        CircularDynamicArray<int> cda;
+        cda.appendRange(src);
+        int ranks[4] = {n / 2, (int)(n * 0.9), (int)(n * 0.99), (int)(n * 0.999)};
+        std::vector<int> separate(4), batched, top;
+
+        double q = timeMs([&] {
+            for (int i = 0; i < 4; i++) {
+                separate[i] = cda.QuickSelect(ranks[i]);
+            }
+        });
+        double m = timeMs([&] { batched = cda.selectMany(ranks); });
+        double t = timeMs([&] { top = cda.topK(1000); });
+        double v = timeMs([&] { std::partial_sort(src.begin(), src.begin() + 1000, src.end()); });
+
+        if (separate != batched || !std::equal(top.begin(), top.end(), src.begin())) {
+            std::cerr << "selectMany/topK mismatch" << std::endl;
+            return 1;
+        }
+        std::cout << n << "\t" << q << "\t" << m << "\t" << t << "\t" << v << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// Builds, clears, refills and destroys many short arrays with CircularDynamicArray and SmallCircularDynamicArray<int, 16>, counting
+// the calls to the global operator new (including the aligned overload the Heap's storage uses) alongside the time.
+
+long long allocationCount = 0;
+
+void *operator new(std::size_t bytes) {
+    allocationCount++;
+    if (void *p = std::malloc(bytes ? bytes : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t bytes, std::align_val_t align) {
+    allocationCount++;
+    std::size_t a = (std::size_t)align;
+    if (void *p = std::aligned_alloc(a, (bytes + a - 1) / a * a)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC cannot see that the aligned operator new above returns memory from aligned_alloc
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+long long sink = 0;
+
+template <typename Array> void run(const char *name, int n, int arrays) {
+    long long before = allocationCount;
+    auto begin = std::chrono::steady_clock::now();
+    for (int a = 0; a < arrays; a++) {
+        Array cda;
+        for (int i = 0; i < n; i++) {
+            cda.addEnd(i + a);
+        }
+        cda.clear();
+        for (int i = 0; i < n; i++) {
+            cda.addFront(i);
+        }
+        sink += cda[n / 2];
+    }
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << "\t" << n << "\t" << (double)(allocationCount - before) / arrays << "\t"
+              << std::chrono::duration<double, std::nano>(finish - begin).count() / arrays << std::endl;
+}
+
+int main() {
+    const int arrays = 1000000;
+    std::cout << "array\telements\tallocations/array\tns/array" << std::endl;
+    for (int n : {4, 12, 16, 64}) {
+        run<CircularDynamicArray<int>>("CircularDynamicArray", n, arrays);
+        run<SmallCircularDynamicArray<int, 16>>("SmallCircularDynamicArray<16>", n, arrays);
+    }
+
+    // The heap holds its array by value
+    long long before = allocationCount;
+    for (int h = 0; h < arrays; h++) {
+        Heap<int> heap;
+        for (int i = 0; i < 8; i++) {
+            heap.insert(8 - i);
+        }
+        sink += heap.extractMin();
+    }
+    std::cout << "Heap<int>, 8 keys\t" << (double)(allocationCount - before) / arrays << " allocations/heap" << std::endl;
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
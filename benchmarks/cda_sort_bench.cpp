@@ -0,0 +1,65 @@
+#include "../datastructs.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Times CircularDynamicArray::stableSort (single threaded and with all hardware threads) and radixSort on random
+// int, uint64_t and double arrays, against std::stable_sort on a std::vector. The largest size can be given as the first argument.
+
+template <typename F> double timeMs(F f) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(finish - begin).count();
+}
+
+template <typename T> CircularDynamicArray<T> makeArray(const std::vector<T> &src) {
+    CircularDynamicArray<T> cda;
+    cda.addEnd(0);
+    cda.prependRange(src); // The ring wraps, so the sorts have to linearize it
+    cda.delEnd();
+    return cda;
+}
+
+template <typename T> int benchType(const char *name, int maxSize) {
+    std::mt19937_64 gen(42);
+
+    std::cout << name << std::endl;
+    std::cout << "size\tstableSort(1)\tstableSort(all)\tradixSort\tstd::stable_sort (ms)" << std::endl;
+    for (int n = 100000; n <= maxSize; n *= 10) {
+        std::vector<T> src(n);
+        for (T &v : src) {
+            if constexpr (std::is_floating_point_v<T>) {
+                v = std::uniform_real_distribution<T>(-1e9, 1e9)(gen);
+            } else {
+                v = (T)gen();
+            }
+        }
+
+        CircularDynamicArray<T> single = makeArray(src), parallel = makeArray(src), radix = makeArray(src);
+        std::vector<T> vec = src;
+
+        double s = timeMs([&] { single.stableSort(1); });
+        double p = timeMs([&] { parallel.stableSort(); });
+        double r = timeMs([&] { radix.radixSort(); });
+        double v = timeMs([&] { std::stable_sort(vec.begin(), vec.end()); });
+
+        if (!std::equal(vec.begin(), vec.end(), single.begin()) || !std::equal(vec.begin(), vec.end(), parallel.begin()) ||
+            !std::equal(vec.begin(), vec.end(), radix.begin())) {
+            std::cerr << "sort mismatch" << std::endl;
+            return 1;
+        }
+        std::cout << n << "\t" << s << "\t" << p << "\t" << r << "\t" << v << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int maxSize = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    return benchType<int>("int", maxSize) | benchType<std::uint64_t>("uint64_t", maxSize) | benchType<double>("double", maxSize);
+}
@@ -0,0 +1,81 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+
+// Sliding window: a batch is appended and the oldest batch dropped, one delFront call per element vs one delFront(n) call.
+// Oscillating load: the size swings back and forth across the shrink threshold; counts how often the capacity changes for a few
+// growth factor / shrink threshold settings.
+
+long long sink = 0;
+
+double slidingWindow(int window, int batch, int rounds, bool bulk) {
+    CircularDynamicArray<long long> cda;
+    for (int i = 0; i < window; i++) {
+        cda.addEnd(i);
+    }
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < batch; i++) {
+            cda.addEnd(r + i);
+        }
+        if (bulk) {
+            cda.delFront(batch);
+        } else {
+            for (int i = 0; i < batch; i++) {
+                cda.delFront();
+            }
+        }
+        sink += cda[0];
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - begin).count() / ((double)batch * rounds);
+}
+
+void oscillate(const char *name, double factor, double threshold) {
+    CircularDynamicArray<long long> cda;
+    cda.setGrowthFactor(factor);
+    cda.setShrinkThreshold(threshold);
+    for (int i = 0; i < 1 << 16; i++) {
+        cda.addEnd(i);
+    }
+    // Drop to just above the threshold (the default one if shrinking is off), then swing 64 elements either side of it
+    double fraction = threshold > 0 ? std::min(threshold, 0.5 / factor) : 0.25;
+    cda.delFront(cda.length() - (int)(cda.capacity() * fraction) - 1);
+
+    int resizes = 0;
+    int lastCap = cda.capacity();
+    auto begin = std::chrono::steady_clock::now();
+    const int rounds = 100000;
+    for (int r = 0; r < rounds; r++) {
+        cda.delFront(64);
+        for (int i = 0; i < 64; i++) {
+            cda.addEnd(i);
+        }
+        if (cda.capacity() != lastCap) {
+            resizes++;
+            lastCap = cda.capacity();
+        }
+    }
+    auto finish = std::chrono::steady_clock::now();
+    sink += cda[0];
+    std::cout << name << "\t" << resizes << "\t"
+              << std::chrono::duration<double, std::nano>(finish - begin).count() / (128.0 * rounds) << std::endl;
+}
+
+int main() {
+    std::cout << "sliding window (ns/element)\tper element\tbulk" << std::endl;
+    for (int batch : {16, 1024, 65536}) {
+        int rounds = 20000000 / batch;
+        std::cout << "batch " << batch << "\t" << slidingWindow(100000, batch, rounds, false) << "\t"
+                  << slidingWindow(100000, batch, rounds, true) << std::endl;
+    }
+
+    std::cout << "oscillating load\tresizes\tns/element" << std::endl;
+    oscillate("growth 2, shrink 0.25", 2.0, 0.25);
+    oscillate("growth 1.5, shrink 0.33", 1.5, 0.5);
+    oscillate("growth 2, no shrink", 2.0, 0.0);
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,57 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+
+// Snapshot cost: deep copy of a CircularDynamicArray vs CowCircularDynamicArray::snapshot. Then 1000 random writes made right after
+// the snapshot, which copy only the chunks they touch, and a full read of the snapshot.
+
+long long sink = 0;
+
+double usSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int main() {
+    std::cout << "size\tCDA copy\tCOW snapshot\t1000 writes after snapshot\tCDA read\tCOW read (us)" << std::endl;
+    for (int n : {100000, 1000000, 10000000}) {
+        CircularDynamicArray<long long> cda;
+        CowCircularDynamicArray<long long> cow;
+        for (int i = 0; i < n; i++) {
+            cda.addEnd(i);
+            cow.addEnd(i);
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        CircularDynamicArray<long long> copy(cda);
+        double copyTime = usSince(begin);
+        sink += copy[n - 1];
+
+        begin = std::chrono::steady_clock::now();
+        CowCircularDynamicArray<long long> snap = cow.snapshot();
+        double snapTime = usSince(begin);
+
+        unsigned x = 7;
+        begin = std::chrono::steady_clock::now();
+        for (int w = 0; w < 1000; w++) {
+            x = x * 1664525u + 1013904223u;
+            cow[(int)(x % (unsigned)n)] = -w;
+        }
+        double writeTime = usSince(begin);
+
+        begin = std::chrono::steady_clock::now();
+        for (long long v : copy) {
+            sink += v;
+        }
+        double cdaRead = usSince(begin);
+
+        begin = std::chrono::steady_clock::now();
+        snap.forEach([](const long long &v) { sink += v; });
+        double cowRead = usSince(begin);
+
+        std::cout << n << "\t" << copyTime << "\t" << snapTime << "\t" << writeTime << "\t" << cdaRead << "\t" << cowRead << std::endl;
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,87 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Compares insertBatch with one insert per key, and extractMinBatch with one extractMin per key, for batches from 1/64 of the heap up to
+// its full size, on a Heap<int, 4> of n random keys. Also drains timers due before a deadline with popUntil vs peekKey/extractMin.
+
+long long sink = 0;
+
+std::vector<int> randomKeys(int n, unsigned seed) {
+    std::vector<int> keys(n);
+    for (int &k : keys) {
+        seed = seed * 1664525u + 1013904223u;
+        k = (int)(seed >> 1);
+    }
+    return keys;
+}
+
+template <typename F> double timeNs(F f) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - begin).count();
+}
+
+int main() {
+    const int n = 1000000;
+    std::vector<int> base = randomKeys(n, 1);
+
+    std::cout << "heap\tbatch\tinsert loop\tinsertBatch\textractMin loop\textractMinBatch (ns/key)" << std::endl;
+    for (int div : {64, 16, 8, 4, 1}) {
+        int m = n / div;
+        std::vector<int> batch = randomKeys(m, div);
+        Heap<int, 4> a(base.data(), n), b(base.data(), n);
+
+        double insertLoop = timeNs([&] {
+            for (int k : batch) {
+                a.insert(k);
+            }
+        });
+        double insertBatch = timeNs([&] { b.insertBatch(batch.begin(), batch.end()); });
+        double extractLoop = timeNs([&] {
+            for (int i = 0; i < m; i++) {
+                sink += a.extractMin();
+            }
+        });
+        double extractBatch = timeNs([&] { sink += b.extractMinBatch(m).back(); });
+
+        std::cout << n << "\t" << m << "\t" << insertLoop / m << "\t" << insertBatch / m << "\t" << extractLoop / m << "\t"
+                  << extractBatch / m << std::endl;
+    }
+
+    // Timers: every tick schedules a batch of deadlines ahead of now and fires the ones that are due
+    std::cout << "timer ticks\tper tick\tinsert + extractMin loop\tinsertBatch + popUntil (ms)" << std::endl;
+    for (int perTick : {1000, 20000}) {
+        const int ticks = 500;
+        Heap<int, 4> a, b;
+        std::vector<int> batch(perTick);
+        unsigned x = 3;
+        double loopNs = 0, batchNs = 0;
+        for (int t = 0; t < ticks; t++) {
+            for (int &k : batch) {
+                x = x * 1664525u + 1013904223u;
+                k = t * 100 + (int)((x >> 8) % 2000);
+            }
+            int now = t * 100;
+            loopNs += timeNs([&] {
+                for (int k : batch) {
+                    a.insert(k);
+                }
+                while (a.size() > 0 && a.peekKey() < now) {
+                    sink += a.extractMin();
+                }
+            });
+            batchNs += timeNs([&] {
+                b.insertBatch(batch.begin(), batch.end());
+                sink += (long long)b.popUntil(now).size();
+            });
+        }
+        std::cout << ticks << "\t" << perTick << "\t" << loopNs / 1e6 << "\t" << batchNs / 1e6 << std::endl;
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <queue>
+#include <vector>
+
+// Inserts n random keys and extracts them all, for heaps of arity 2, 4 and 8 and for std::priority_queue as a reference.
+
+long long sink = 0;
+
+template <typename Queue> void run(Queue &q, const std::vector<int> &keys, double &insertNs, double &extractNs) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int k : keys) {
+        q.insert(k);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        sink += q.extractMin();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    insertNs = std::chrono::duration<double, std::nano>(middle - begin).count() / keys.size();
+    extractNs = std::chrono::duration<double, std::nano>(finish - middle).count() / keys.size();
+}
+
+// Adapts std::priority_queue to the Heap interface
+struct StdQueue {
+    std::priority_queue<int, std::vector<int>, std::greater<int>> q;
+    void insert(int k) { q.push(k); }
+    int extractMin() {
+        int k = q.top();
+        q.pop();
+        return k;
+    }
+};
+
+int main() {
+    std::cout << "size\tqueue\tinsert\textractMin (ns/op)" << std::endl;
+    for (int n : {100000, 1000000, 10000000}) {
+        std::vector<int> keys(n);
+        unsigned x = 1;
+        for (int &k : keys) {
+            x = x * 1664525u + 1013904223u;
+            k = (int)(x >> 1);
+        }
+
+        double insertNs, extractNs;
+        {
+            Heap<int, 2> h;
+            run(h, keys, insertNs, extractNs);
+            std::cout << n << "\tHeap<int, 2>\t" << insertNs << "\t" << extractNs << std::endl;
+        }
+        {
+            Heap<int, 4> h;
+            run(h, keys, insertNs, extractNs);
+            std::cout << n << "\tHeap<int, 4>\t" << insertNs << "\t" << extractNs << std::endl;
+        }
+        {
+            Heap<int, 8> h;
+            run(h, keys, insertNs, extractNs);
+            std::cout << n << "\tHeap<int, 8>\t" << insertNs << "\t" << extractNs << std::endl;
+        }
+        {
+            StdQueue q;
+            run(q, keys, insertNs, extractNs);
+            std::cout << n << "\tstd::priority_queue\t" << insertNs << "\t" << extractNs << std::endl;
+        }
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,45 @@
+#include "../datastructs.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Sorts n random ints in place with Heap::heapSort of arity 2, 4 and 8, with std::make_heap + std::sort_heap as the
+// reference heapsort, and with std::sort.
+
+long long sink = 0;
+
+template <typename Sort> double run(const std::vector<int> &keys, Sort sort) {
+    std::vector<int> v = keys;
+    auto begin = std::chrono::steady_clock::now();
+    sort(v);
+    auto finish = std::chrono::steady_clock::now();
+    sink += v[v.size() / 2];
+    return std::chrono::duration<double, std::nano>(finish - begin).count() / keys.size();
+}
+
+int main() {
+    std::cout << "size\tarity 2\tarity 4\tarity 8\tstd::sort_heap\tstd::sort (ns/key)" << std::endl;
+    for (int n : {10000, 1000000, 10000000}) {
+        std::vector<int> keys(n);
+        unsigned x = 1;
+        for (int &k : keys) {
+            x = x * 1664525u + 1013904223u;
+            k = (int)(x >> 1);
+        }
+
+        std::cout << n
+                  << "\t" << run(keys, [](std::vector<int> &v) { Heap<int, 2>::heapSort(v.data(), (int)v.size()); })
+                  << "\t" << run(keys, [](std::vector<int> &v) { Heap<int, 4>::heapSort(v.data(), (int)v.size()); })
+                  << "\t" << run(keys, [](std::vector<int> &v) { Heap<int, 8>::heapSort(v.data(), (int)v.size()); })
+                  << "\t" << run(keys, [](std::vector<int> &v) {
+                         std::make_heap(v.begin(), v.end());
+                         std::sort_heap(v.begin(), v.end());
+                     })
+                  << "\t" << run(keys, [](std::vector<int> &v) { std::sort(v.begin(), v.end()); }) << std::endl;
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
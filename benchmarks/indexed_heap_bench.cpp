@@ -0,0 +1,124 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Runs Dijkstra's algorithm on a random sparse graph twice: once with a Heap that takes duplicate entries and skips the stale ones
+// (lazy deletion), and once with an IndexedHeap that lowers queued distances in place through decreaseKey. Prints the time and the
+// largest number of keys each heap held.
+
+long long sink = 0;
+
+struct Graph {
+    std::vector<int> first;
+    std::vector<int> to;
+    std::vector<long long> weight;
+};
+
+Graph randomGraph(int n, int degree) {
+    Graph g;
+    g.first.resize(n + 1);
+    unsigned x = 12345;
+    for (int v = 0; v < n; v++) {
+        g.first[v] = (int)g.to.size();
+        for (int e = 0; e < degree; e++) {
+            x = x * 1664525u + 1013904223u;
+            g.to.push_back((x >> 8) % n);
+            x = x * 1664525u + 1013904223u;
+            g.weight.push_back(1 + (x >> 8) % 1000);
+        }
+    }
+    g.first[n] = (int)g.to.size();
+    return g;
+}
+
+double lazy(const Graph &g, int n, int &peak) {
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<long long> dist(n, -1);
+    std::vector<char> done(n, 0);
+    Heap<std::pair<long long, int>> q;
+    dist[0] = 0;
+    q.insert({0, 0});
+    peak = 1;
+    while (q.size() > 0) {
+        auto [d, v] = q.extractMin();
+        if (done[v]) {
+            continue;
+        }
+        done[v] = 1;
+        for (int e = g.first[v]; e < g.first[v + 1]; e++) {
+            int w = g.to[e];
+            long long nd = d + g.weight[e];
+            if (dist[w] == -1 || nd < dist[w]) {
+                dist[w] = nd;
+                q.insert({nd, w});
+            }
+        }
+        peak = std::max(peak, q.size());
+    }
+    auto finish = std::chrono::steady_clock::now();
+    for (long long d : dist) {
+        sink += d;
+    }
+    return std::chrono::duration<double, std::milli>(finish - begin).count();
+}
+
+double indexed(const Graph &g, int n, int &peak) {
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<long long> dist(n, -1);
+    std::vector<int> handle(n, -1);
+    std::vector<int> vertex;
+    std::vector<char> done(n, 0);
+    IndexedHeap<long long> q;
+    dist[0] = 0;
+    handle[0] = q.insert(0);
+    vertex.assign(1, 0);
+    peak = 1;
+    while (q.size() > 0) {
+        int v = vertex[q.peekHandle()];
+        long long d = q.extractMin();
+        done[v] = 1;
+        for (int e = g.first[v]; e < g.first[v + 1]; e++) {
+            int w = g.to[e];
+            long long nd = d + g.weight[e];
+            if (done[w]) {
+                continue;
+            }
+            if (dist[w] == -1) {
+                dist[w] = nd;
+                handle[w] = q.insert(nd);
+                if (handle[w] >= (int)vertex.size()) {
+                    vertex.resize(handle[w] + 1);
+                }
+                vertex[handle[w]] = w;
+            } else if (nd < dist[w]) {
+                dist[w] = nd;
+                q.decreaseKey(handle[w], nd);
+            }
+        }
+        peak = std::max(peak, q.size());
+    }
+    auto finish = std::chrono::steady_clock::now();
+    for (long long d : dist) {
+        sink += d;
+    }
+    return std::chrono::duration<double, std::milli>(finish - begin).count();
+}
+
+int main() {
+    std::cout << "vertices\tdegree\tlazy Heap (ms)\tpeak keys\tIndexedHeap (ms)\tpeak keys" << std::endl;
+    for (int n : {100000, 1000000}) {
+        for (int degree : {4, 16}) {
+            Graph g = randomGraph(n, degree);
+            int lazyPeak, indexedPeak;
+            double lazyMs = lazy(g, n, lazyPeak);
+            double indexedMs = indexed(g, n, indexedPeak);
+            std::cout << n << "\t" << degree << "\t" << lazyMs << "\t" << lazyPeak << "\t" << indexedMs << "\t" << indexedPeak << std::endl;
+        }
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
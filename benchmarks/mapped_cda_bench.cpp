@@ -0,0 +1,84 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+// Checkpoints a ring of fixed-size records and loads it back: element by element through a file stream into addEnd, versus
+// reopening a MappedCircularDynamicArray. The number of records can be set with the first argument.
+
+struct Record {
+    std::int64_t id;
+    double value;
+};
+
+long long sink = 0;
+
+double msSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 20000000;
+    const char *streamPath = "mapped_cda_bench_stream.bin";
+    const char *mappedPath = "mapped_cda_bench_mapped.bin";
+    std::remove(streamPath);
+    std::remove(mappedPath);
+
+    // Serialized checkpoint
+    {
+        CircularDynamicArray<Record> cda;
+        for (int i = 0; i < n; i++) {
+            cda.addEnd(Record{i, i * 0.5});
+        }
+        auto begin = std::chrono::steady_clock::now();
+        FILE *f = std::fopen(streamPath, "wb");
+        for (int i = 0; i < n; i++) {
+            std::fwrite(&cda[i], sizeof(Record), 1, f);
+        }
+        std::fclose(f);
+        std::cout << "stream save\t" << msSince(begin) << " ms" << std::endl;
+    }
+    {
+        auto begin = std::chrono::steady_clock::now();
+        CircularDynamicArray<Record> cda;
+        FILE *f = std::fopen(streamPath, "rb");
+        Record r;
+        while (std::fread(&r, sizeof(Record), 1, f) == 1) {
+            cda.addEnd(r);
+        }
+        std::fclose(f);
+        sink += cda[n - 1].id;
+        std::cout << "stream load\t" << msSince(begin) << " ms" << std::endl;
+    }
+
+    // Memory-mapped array
+    {
+        auto begin = std::chrono::steady_clock::now();
+        MappedCircularDynamicArray<Record> mcda(mappedPath);
+        for (int i = 0; i < n; i++) {
+            mcda.addEnd(Record{i, i * 0.5});
+        }
+        std::cout << "mapped fill\t" << msSince(begin) << " ms" << std::endl;
+    }
+    {
+        auto begin = std::chrono::steady_clock::now();
+        MappedCircularDynamicArray<Record> mcda(mappedPath);
+        sink += mcda[n - 1].id;
+        std::cout << "mapped reopen\t" << msSince(begin) << " ms" << std::endl;
+
+        begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; i++) {
+            sink += mcda[i].id;
+        }
+        std::cout << "mapped scan\t" << msSince(begin) << " ms" << std::endl;
+    }
+
+    std::remove(streamPath);
+    std::remove(mappedPath);
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+#include "../datastructs.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Contention benchmark for MPMCRingBuffer against a mutex-wrapped circular dynamic array.
+// Runs T producers and T consumers for T = 1, 2, 4, ... up to N (first argument, default: hardware threads).
+
+const int messages = 2000000;
+const int ringCapacity = 4096;
+
+/**
+ * @brief Mutex-wrapped circular dynamic array with the same interface as MPMCRingBuffer
+ */
+class MutexQueue {
+    public:
+    bool addEnd(int v) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (cda.length() >= ringCapacity) {
+            return false;
+        }
+        cda.addEnd(v);
+        return true;
+    }
+
+    bool delFront(int &out) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (cda.length() == 0) {
+            return false;
+        }
+        out = cda[0];
+        cda.delFront();
+        return true;
+    }
+
+    private:
+    CircularDynamicArray<int> cda;
+    std::mutex lock;
+};
+
+template <typename queue> double run(queue &q, int threads) {
+    std::atomic<int> received = 0;
+    std::atomic<long long> sum = 0;
+    std::vector<std::thread> workers;
+    int perProducer = messages / threads;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < perProducer;) {
+                if (q.addEnd(i)) {
+                    i++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        workers.emplace_back([&] {
+            long long local = 0;
+            int v;
+            while (received.load(std::memory_order_relaxed) < perProducer * threads) {
+                if (q.delFront(v)) {
+                    local += v;
+                    received++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            sum += local;
+        });
+    }
+    for (std::thread &w : workers) {
+        w.join();
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    if (sum != (long long)threads * perProducer * (perProducer - 1) / 2) {
+        std::cerr << "checksum mismatch" << std::endl;
+    }
+    return perProducer * threads / std::chrono::duration<double>(finish - begin).count();
+}
+
+int main(int argc, char **argv) {
+    int maxThreads = argc > 1 ? std::atoi(argv[1]) : (int)std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "producers+consumers\tmutex CDA\tMPMCRingBuffer (messages/s)" << std::endl;
+    for (int t = 1; t <= maxThreads; t *= 2) {
+        MutexQueue mq;
+        MPMCRingBuffer<int> ring(ringCapacity);
+        double m = run(mq, t);
+        double r = run(ring, t);
+        std::cout << t << "+" << t << "\t" << m << "\t" << r << std::endl;
+    }
+    return 0;
+}
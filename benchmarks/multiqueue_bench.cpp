@@ -0,0 +1,133 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Measures throughput from 1 to 64 threads, each alternating insert and delete-min on a prefilled queue, for a mutex-guarded
+// Heap and for MultiQueue with 2 and 4 shards per thread. Then measures the order quality of MultiQueue: the rank error of each
+// removed key (how many smaller keys were in the queue) in a single-threaded replay, counted with a Fenwick tree over the keys.
+
+long long sink = 0;
+
+// Adapts a mutex-guarded Heap to the MultiQueue interface
+struct LockedHeap {
+    std::mutex m;
+    Heap<int, 4> heap;
+    void insert(int k) {
+        std::lock_guard<std::mutex> guard(m);
+        heap.insert(k);
+    }
+    bool tryExtractMin(int &out) {
+        std::lock_guard<std::mutex> guard(m);
+        if (heap.size() == 0) {
+            return false;
+        }
+        out = heap.extractMin();
+        return true;
+    }
+};
+
+template <typename Queue> double throughput(Queue &q, int threads, int totalOps) {
+    unsigned x = 1;
+    for (int i = 0; i < 1000000; i++) {
+        x = x * 1664525u + 1013904223u;
+        q.insert((int)(x >> 1));
+    }
+
+    std::vector<long long> sums(threads, 0);
+    std::vector<std::thread> workers;
+    auto begin = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            unsigned y = t + 7;
+            int k;
+            for (int i = 0; i < totalOps / threads / 2; i++) {
+                y = y * 1664525u + 1013904223u;
+                q.insert((int)(y >> 1));
+                if (q.tryExtractMin(k)) {
+                    sums[t] += k;
+                }
+            }
+        });
+    }
+    for (std::thread &w : workers) {
+        w.join();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    for (long long s : sums) {
+        sink += s;
+    }
+    return totalOps / std::chrono::duration<double, std::micro>(finish - begin).count();
+}
+
+// Counts the keys present in [0, n) with prefix sums in O(lg(n))
+struct Fenwick {
+    std::vector<int> tree;
+    explicit Fenwick(int n) : tree(n + 1, 0) {}
+    void add(int k, int d) {
+        for (k++; k < (int)tree.size(); k += k & -k) {
+            tree[k] += d;
+        }
+    }
+    int below(int k) {
+        int c = 0;
+        for (; k > 0; k -= k & -k) {
+            c += tree[k];
+        }
+        return c;
+    }
+};
+
+void rankError(int threads, int shardsPerThread, int n, double &mean, int &max) {
+    MultiQueue<int> q(threads, shardsPerThread);
+    Fenwick present(4 * n);
+    int next = 0;
+    for (; next < n; next++) {
+        int key = (int)(((long long)next * 7919) % (4 * n));
+        q.insert(key);
+        present.add(key, 1);
+    }
+    long long total = 0;
+    max = 0;
+    for (int i = 0; i < n; i++) {
+        int k;
+        q.tryExtractMin(k);
+        int error = present.below(k);
+        total += error;
+        max = std::max(max, error);
+        present.add(k, -1);
+        int key = (int)(((long long)next++ * 7919) % (4 * n));
+        q.insert(key);
+        present.add(key, 1);
+    }
+    mean = (double)total / n;
+}
+
+int main() {
+    const int totalOps = 4000000;
+    std::cout << "threads\tmutex + Heap\tMultiQueue c=2\tMultiQueue c=4 (Mops/s)" << std::endl;
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        LockedHeap locked;
+        MultiQueue<int> mq2(threads, 2), mq4(threads, 4);
+        double lockedRate = throughput(locked, threads, totalOps);
+        double mq2Rate = throughput(mq2, threads, totalOps);
+        double mq4Rate = throughput(mq4, threads, totalOps);
+        std::cout << threads << "\t" << lockedRate << "\t" << mq2Rate << "\t" << mq4Rate << std::endl;
+    }
+
+    std::cout << "threads\tshards\tmean rank error\tmax rank error" << std::endl;
+    for (int threads : {1, 4, 16, 64}) {
+        for (int c : {2, 4}) {
+            double mean;
+            int max;
+            rankError(threads, c, 100000, mean, max);
+            std::cout << threads << "\t" << threads * c << "\t" << mean << "\t" << max << std::endl;
+        }
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
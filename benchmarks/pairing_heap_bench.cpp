@@ -0,0 +1,153 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Compares PairingHeap with Heap on two workloads:
+// - Dijkstra's algorithm on a random sparse graph: Heap with lazy deletion vs PairingHeap::decreaseKey
+// - Merging per-shard heaps: each round every shard takes a batch of keys, all shards are merged into one heap and 1/2 or 1/16 of the
+//   round's keys are extracted from it. Heap merges by draining the shard with extractMinBatch and calling insertBatch; PairingHeap
+//   uses meld.
+
+long long sink = 0;
+
+struct Graph {
+    std::vector<int> first;
+    std::vector<int> to;
+    std::vector<long long> weight;
+};
+
+Graph randomGraph(int n, int degree) {
+    Graph g;
+    g.first.resize(n + 1);
+    unsigned x = 12345;
+    for (int v = 0; v < n; v++) {
+        g.first[v] = (int)g.to.size();
+        for (int e = 0; e < degree; e++) {
+            x = x * 1664525u + 1013904223u;
+            g.to.push_back((x >> 8) % n);
+            x = x * 1664525u + 1013904223u;
+            g.weight.push_back(1 + (x >> 8) % 1000);
+        }
+    }
+    g.first[n] = (int)g.to.size();
+    return g;
+}
+
+double dijkstraHeap(const Graph &g, int n) {
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<long long> dist(n, -1);
+    std::vector<char> done(n, 0);
+    Heap<std::pair<long long, int>> q;
+    dist[0] = 0;
+    q.insert({0, 0});
+    while (q.size() > 0) {
+        auto [d, v] = q.extractMin();
+        if (done[v]) {
+            continue;
+        }
+        done[v] = 1;
+        for (int e = g.first[v]; e < g.first[v + 1]; e++) {
+            int w = g.to[e];
+            long long nd = d + g.weight[e];
+            if (dist[w] == -1 || nd < dist[w]) {
+                dist[w] = nd;
+                q.insert({nd, w});
+            }
+        }
+    }
+    auto finish = std::chrono::steady_clock::now();
+    for (long long d : dist) {
+        sink += d;
+    }
+    return std::chrono::duration<double, std::milli>(finish - begin).count();
+}
+
+double dijkstraPairing(const Graph &g, int n) {
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<long long> dist(n, -1);
+    std::vector<PairingHeap<std::pair<long long, int>>::Handle> handle(n);
+    std::vector<char> done(n, 0);
+    PairingHeap<std::pair<long long, int>> q;
+    dist[0] = 0;
+    handle[0] = q.insert({0, 0});
+    while (q.size() > 0) {
+        auto [d, v] = q.extractMin();
+        done[v] = 1;
+        for (int e = g.first[v]; e < g.first[v + 1]; e++) {
+            int w = g.to[e];
+            long long nd = d + g.weight[e];
+            if (done[w]) {
+                continue;
+            }
+            if (dist[w] == -1) {
+                dist[w] = nd;
+                handle[w] = q.insert({nd, w});
+            } else if (nd < dist[w]) {
+                dist[w] = nd;
+                q.decreaseKey(handle[w], {nd, w});
+            }
+        }
+    }
+    auto finish = std::chrono::steady_clock::now();
+    for (long long d : dist) {
+        sink += d;
+    }
+    return std::chrono::duration<double, std::milli>(finish - begin).count();
+}
+
+template <typename Queue, typename Merge> double shards(int shardCount, int perShard, int rounds, int extractDiv, Merge merge) {
+    auto begin = std::chrono::steady_clock::now();
+    Queue main;
+    std::vector<Queue> parts(shardCount);
+    unsigned x = 99;
+    for (int r = 0; r < rounds; r++) {
+        for (Queue &p : parts) {
+            for (int i = 0; i < perShard; i++) {
+                x = x * 1664525u + 1013904223u;
+                p.insert((int)(x >> 1));
+            }
+        }
+        for (Queue &p : parts) {
+            merge(main, p);
+        }
+        for (int i = 0; i < shardCount * perShard / extractDiv; i++) {
+            sink += main.extractMin();
+        }
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(finish - begin).count();
+}
+
+int main() {
+    std::cout << "vertices\tdegree\tHeap, lazy deletion (ms)\tPairingHeap, decreaseKey (ms)" << std::endl;
+    for (int n : {100000, 1000000}) {
+        for (int degree : {4, 16}) {
+            Graph g = randomGraph(n, degree);
+            double heapMs = dijkstraHeap(g, n);
+            double pairingMs = dijkstraPairing(g, n);
+            std::cout << n << "\t" << degree << "\t" << heapMs << "\t" << pairingMs << std::endl;
+        }
+    }
+
+    std::cout << "shards\tkeys/shard/round\trounds\textracted\tHeap, drain + insertBatch (ms)\tPairingHeap, meld (ms)" << std::endl;
+    for (int extractDiv : {2, 16}) {
+        for (int perShard : {100, 10000}) {
+            const int shardCount = 16;
+            int rounds = 2000000 / (shardCount * perShard);
+            double heapMs = shards<Heap<int>>(shardCount, perShard, rounds, extractDiv, [](Heap<int> &main, Heap<int> &p) {
+                std::vector<int> keys = p.extractMinBatch(p.size());
+                main.insertBatch(keys.begin(), keys.end());
+            });
+            double pairingMs = shards<PairingHeap<int>>(shardCount, perShard, rounds, extractDiv,
+                                                        [](PairingHeap<int> &main, PairingHeap<int> &p) { main.meld(p); });
+            std::cout << shardCount << "\t" << perShard << "\t" << rounds << "\t1/" << extractDiv << "\t" << heapMs << "\t" << pairingMs
+                      << std::endl;
+        }
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
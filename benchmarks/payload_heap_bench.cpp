@@ -0,0 +1,78 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Inserts n random keys, each with a payload of P bytes, and extracts them all: once with PayloadHeap, which sifts only
+// the key and a payload index, and once with a Heap of structs that carry the payload next to the key.
+
+long long sink = 0;
+
+template <int P> struct Payload {
+    char bytes[P];
+};
+
+template <int P> struct Record {
+    int key;
+    Payload<P> payload;
+
+    bool operator<(const Record &other) const { return key < other.key; }
+};
+
+template <int P> double payloadHeap(const std::vector<int> &keys) {
+    PayloadHeap<int, Payload<P>, 4> h;
+    auto begin = std::chrono::steady_clock::now();
+    for (int k : keys) {
+        Payload<P> p;
+        p.bytes[0] = (char)k;
+        h.insert(k, p);
+    }
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        std::pair<int, Payload<P>> min = h.extractMin();
+        sink += min.first + min.second.bytes[0];
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - begin).count() / keys.size();
+}
+
+template <int P> double recordHeap(const std::vector<int> &keys) {
+    Heap<Record<P>, 4> h;
+    auto begin = std::chrono::steady_clock::now();
+    for (int k : keys) {
+        Record<P> r;
+        r.key = k;
+        r.payload.bytes[0] = (char)k;
+        h.insert(r);
+    }
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        Record<P> min = h.extractMin();
+        sink += min.key + min.payload.bytes[0];
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - begin).count() / keys.size();
+}
+
+template <int P> void row(const std::vector<int> &keys) {
+    std::cout << P << "\t" << payloadHeap<P>(keys) << "\t" << recordHeap<P>(keys) << std::endl;
+}
+
+int main() {
+    const int n = 1000000;
+    std::vector<int> keys(n);
+    unsigned x = 1;
+    for (int &k : keys) {
+        x = x * 1664525u + 1013904223u;
+        k = (int)(x >> 1);
+    }
+
+    std::cout << "payload bytes\tPayloadHeap\tHeap of records (ns per insert + extractMin)" << std::endl;
+    row<4>(keys);
+    row<16>(keys);
+    row<64>(keys);
+    row<256>(keys);
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
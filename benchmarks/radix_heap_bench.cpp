@@ -0,0 +1,104 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Compares RadixHeap with Heap on monotone workloads:
+// - Timers: a heap of n deadlines where each step fires the earliest one and schedules a new one up to 2^20 ticks later
+// - Dijkstra's algorithm on a random sparse graph with lazy deletion, the distance and vertex packed into one 64-bit key
+
+long long sink = 0;
+
+template <typename Queue> double timers(int n, int steps) {
+    Queue q;
+    std::uint64_t x = 1;
+    for (int i = 0; i < n; i++) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        q.insert((std::uint32_t)(x >> 44));
+    }
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; i++) {
+        std::uint32_t now = q.extractMin();
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        q.insert(now + (std::uint32_t)(x >> 44));
+        sink += now;
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - begin).count() / steps;
+}
+
+struct Graph {
+    std::vector<int> first;
+    std::vector<int> to;
+    std::vector<std::uint64_t> weight;
+};
+
+Graph randomGraph(int n, int degree) {
+    Graph g;
+    g.first.resize(n + 1);
+    unsigned x = 12345;
+    for (int v = 0; v < n; v++) {
+        g.first[v] = (int)g.to.size();
+        for (int e = 0; e < degree; e++) {
+            x = x * 1664525u + 1013904223u;
+            g.to.push_back((x >> 8) % n);
+            x = x * 1664525u + 1013904223u;
+            g.weight.push_back(1 + (x >> 8) % 1000);
+        }
+    }
+    g.first[n] = (int)g.to.size();
+    return g;
+}
+
+template <typename Queue> double dijkstra(const Graph &g, int n) {
+    const int vertexBits = 20;
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::uint64_t> dist(n, UINT64_MAX);
+    Queue q;
+    dist[0] = 0;
+    q.insert(0);
+    while (q.size() > 0) {
+        std::uint64_t key = q.extractMin();
+        std::uint64_t d = key >> vertexBits;
+        int v = (int)(key & ((1 << vertexBits) - 1));
+        if (d != dist[v]) {
+            continue;
+        }
+        for (int e = g.first[v]; e < g.first[v + 1]; e++) {
+            int w = g.to[e];
+            std::uint64_t nd = d + g.weight[e];
+            if (nd < dist[w]) {
+                dist[w] = nd;
+                q.insert(nd << vertexBits | (std::uint64_t)w);
+            }
+        }
+    }
+    auto finish = std::chrono::steady_clock::now();
+    for (std::uint64_t d : dist) {
+        sink += d;
+    }
+    return std::chrono::duration<double, std::milli>(finish - begin).count();
+}
+
+int main() {
+    std::cout << "timers\tRadixHeap\tHeap<2>\tHeap<4> (ns/step)" << std::endl;
+    for (int n : {1000, 100000, 1000000}) {
+        const int steps = 5000000;
+        std::cout << n << "\t" << timers<RadixHeap<std::uint32_t>>(n, steps) << "\t" << timers<Heap<std::uint32_t, 2>>(n, steps) << "\t"
+                  << timers<Heap<std::uint32_t, 4>>(n, steps) << std::endl;
+    }
+
+    std::cout << "vertices\tdegree\tRadixHeap\tHeap<2>\tHeap<4> (ms)" << std::endl;
+    for (int n : {100000, 1000000}) {
+        for (int degree : {4, 16}) {
+            Graph g = randomGraph(n, degree);
+            std::cout << n << "\t" << degree << "\t" << dijkstra<RadixHeap<std::uint64_t>>(g, n) << "\t"
+                      << dijkstra<Heap<std::uint64_t, 2>>(g, n) << "\t" << dijkstra<Heap<std::uint64_t, 4>>(g, n) << std::endl;
+        }
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
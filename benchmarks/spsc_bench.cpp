@@ -0,0 +1,105 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// Measures producer to consumer hand-off throughput of the lock-free SPSCRingBuffer against a mutex-wrapped circular dynamic array.
+// Both sides yield when the queue is full or empty so the benchmark also behaves on machines with few cores.
+
+const int messages = 5000000;
+const int ringCapacity = 4096;
+
+double mutexCDA() {
+    CircularDynamicArray<int> cda;
+    std::mutex lock;
+
+    auto begin = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        for (int i = 0; i < messages;) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (cda.length() < ringCapacity) {
+                cda.addEnd(i++);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    long long sum = 0;
+    for (int received = 0; received < messages;) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (cda.length() > 0) {
+            sum += cda[0];
+            cda.delFront();
+            received++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    auto finish = std::chrono::steady_clock::now();
+
+    if (sum != (long long)messages * (messages - 1) / 2) {
+        std::cerr << "mutex checksum mismatch" << std::endl;
+    }
+    return messages / std::chrono::duration<double>(finish - begin).count();
+}
+
+double spsc(int batch) {
+    SPSCRingBuffer<int> ring(ringCapacity);
+
+    auto begin = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        int chunk[256];
+        for (int i = 0; i < messages;) {
+            int added;
+            if (batch == 1) {
+                added = ring.addEnd(i);
+            } else {
+                int n = std::min(batch, messages - i);
+                for (int j = 0; j < n; j++) {
+                    chunk[j] = i + j;
+                }
+                added = ring.addEndBatch(chunk, n);
+            }
+            if (added == 0) {
+                std::this_thread::yield();
+            }
+            i += added;
+        }
+    });
+    long long sum = 0;
+    int chunk[256];
+    for (int received = 0; received < messages;) {
+        int n = 0;
+        if (batch == 1) {
+            n = ring.delFront(chunk[0]);
+        } else {
+            n = ring.delFrontBatch(chunk, batch);
+        }
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (int j = 0; j < n; j++) {
+            sum += chunk[j];
+        }
+        received += n;
+    }
+    producer.join();
+    auto finish = std::chrono::steady_clock::now();
+
+    if (sum != (long long)messages * (messages - 1) / 2) {
+        std::cerr << "spsc checksum mismatch" << std::endl;
+    }
+    return messages / std::chrono::duration<double>(finish - begin).count();
+}
+
+int main() {
+    std::cout << "queue\tmessages/s" << std::endl;
+    std::cout << "mutex + CircularDynamicArray\t" << mutexCDA() << std::endl;
+    std::cout << "SPSCRingBuffer\t" << spsc(1) << std::endl;
+    std::cout << "SPSCRingBuffer (batch 32)\t" << spsc(32) << std::endl;
+    std::cout << "SPSCRingBuffer (batch 256)\t" << spsc(256) << std::endl;
+    return 0;
+}
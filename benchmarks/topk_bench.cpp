@@ -0,0 +1,57 @@
+#include "../datastructs.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+// Tracks the 1000 largest of n samples with TopKTracker and with a maximum Heap that takes every sample and is popped K times at report
+// time. Reports time per sample and the number of keys each structure holds. Random samples are mostly rejected by the tracker; an
+// ascending stream is its worst case, where every sample is accepted.
+
+long long sink = 0;
+
+template <typename F> double nsPerSample(F f, int n) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - begin).count() / n;
+}
+
+int main() {
+    const int k = 1000;
+    std::cout << "samples\tstream\tTopKTracker (ns/sample)\tkeys held\tHeap + pop K (ns/sample)\tkeys held" << std::endl;
+    for (int n : {1000000, 10000000}) {
+        for (bool ascending : {false, true}) {
+            std::vector<int> samples(n);
+            unsigned x = 1;
+            for (int i = 0; i < n; i++) {
+                x = x * 1664525u + 1013904223u;
+                samples[i] = ascending ? i : (int)(x >> 1);
+            }
+
+            int trackerHeld = 0, heapHeld = 0;
+            double trackerNs = nsPerSample([&] {
+                TopKTracker<int> top(k);
+                for (int v : samples) {
+                    top.push(v);
+                }
+                trackerHeld = top.size();
+                sink += top.sorted()[0];
+            }, n);
+            double heapNs = nsPerSample([&] {
+                Heap<int, 4, std::greater<int>> all;
+                for (int v : samples) {
+                    all.insert(v);
+                }
+                heapHeld = all.size();
+                sink += all.extractMinBatch(k)[0];
+            }, n);
+            std::cout << n << "\t" << (ascending ? "ascending" : "random") << "\t" << trackerNs << "\t" << trackerHeld << "\t" << heapNs
+                      << "\t" << heapHeld << std::endl;
+        }
+    }
+
+    // Keeps the optimizer from discarding the loops
+    return sink == 42 ? 1 : 0;
+}
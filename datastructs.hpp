@@ -5,785 +5,5394 @@
  * 
  * @details This file includes the following data structures:
  * * - Circular Dynamic Array
+ * * - Copy-on-Write Circular Dynamic Array
+ * * - Mapped Circular Dynamic Array
+ * * - Eytzinger Index
+ * * - SPSC Ring Buffer
+ * * - MPMC Ring Buffer
  * * - Heap
+ * * - Payload Heap
+ * * - Indexed Heap
+ * * - Pairing Heap
+ * * - MultiQueue
+ * * - Top-K Tracker
+ * * - Radix Heap
  * * - Red-Black Tree
  */
 
 #ifndef DATASTRUCTS_H
 #define DATASTRUCTS_H
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define DATASTRUCTS_X86_SIMD 1
+#else
+#define DATASTRUCTS_X86_SIMD 0
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DATASTRUCTS_POSIX_MMAP 1
+#else
+#define DATASTRUCTS_POSIX_MMAP 0
+#endif
+
+/**
+ * @brief Assumed size of a cache line in bytes, used to keep independently written data apart
+ */
+constexpr std::size_t cacheLineSize = 64;
+
+/**
+ * @brief Vectorized equality search kernels for contiguous arrays
+ * 
+ * @details Integral types and float/double of 1, 2, 4 or 8 bytes are compared 16 bytes at a time with SSE2 or 32 bytes at a time with AVX2,
+ *          chosen at runtime from the CPU features; other types and other platforms use a scalar loop. Floating-point elements follow
+ *          operator== (-0.0 matches 0.0, NaN matches nothing). Used by the circular dynamic array on each of its two contiguous segments.
+ */
+struct SimdSearch {
+    /**
+     * @brief What a scan reports: the first match, the number of matches, or every matching index
+     */
+    enum searchMode { first, count, all };
+
+    /**
+     * @brief Whether the vector kernels handle elements of type T
+     */
+    template <typename T> static constexpr bool vectorizable =
+        (std::is_integral_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+    /**
+     * @brief Returns the index of the first element equal to e, or -1
+     */
+    template <typename T> static int find(const T *arr, int n, const T &e) { return scan(arr, n, e, first, nullptr, 0); }
+
+    /**
+     * @brief Returns the number of elements equal to e
+     */
+    template <typename T> static int countOf(const T *arr, int n, const T &e) { return scan(arr, n, e, count, nullptr, 0); }
+
+    /**
+     * @brief Appends offset + i to out for every index i with arr[i] == e and returns the number of matches
+     */
+    template <typename T> static int findAll(const T *arr, int n, const T &e, std::vector<int> &out, int offset) {
+        return scan(arr, n, e, all, &out, offset);
+    }
+
+    /**
+     * @brief Runs the widest kernel the CPU supports
+     * 
+     * @details Time complexity: O(n)
+     * 
+     * @param arr The array to search
+     * @param n The length of the array
+     * @param e The element to search for
+     * @param mode What to report
+     * @param out Receives the matching indices in mode all
+     * @param offset Added to every index written to out
+     * 
+     * @return The first matching index or -1 in mode first, the number of matches otherwise
+     */
+    template <typename T> static int scan(const T *arr, int n, const T &e, searchMode mode, std::vector<int> *out, int offset) {
+#if DATASTRUCTS_X86_SIMD
+        if constexpr (vectorizable<T>) {
+            static const bool avx2 = __builtin_cpu_supports("avx2");
+            return avx2 ? scanAVX2(arr, n, e, mode, out, offset) : scanSSE2(arr, n, e, mode, out, offset);
+        }
+#endif
+        return scanScalar(arr, n, e, mode, out, offset, 0);
+    }
+
+    /**
+     * @brief Scalar kernel, also used for the elements after the last full vector
+     * 
+     * @param from The index to start at
+     */
+    template <typename T> static int scanScalar(const T *arr, int n, const T &e, searchMode mode, std::vector<int> *out, int offset, int from) {
+        int matches = 0;
+        for (int i = from; i < n; i++) {
+            if (arr[i] == e) {
+                if (mode == first) {
+                    return i;
+                }
+                if (mode == all) {
+                    out->push_back(offset + i);
+                }
+                matches++;
+            }
+        }
+        return mode == first ? -1 : matches;
+    }
+
+#if DATASTRUCTS_X86_SIMD
+    /**
+     * @brief SSE2 kernel comparing 16 bytes per step
+     */
+    template <typename T> static int scanSSE2(const T *arr, int n, const T &e, searchMode mode, std::vector<int> *out, int offset) {
+        constexpr int lanes = 16 / sizeof(T);
+        T repeated[lanes];
+        std::fill_n(repeated, lanes, e);
+        __m128i needle = _mm_loadu_si128((const __m128i *)repeated);
+
+        int matches = 0, i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            __m128i block = _mm_loadu_si128((const __m128i *)(arr + i)), eq;
+            if constexpr (std::is_same_v<T, float>) {
+                eq = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)));
+            } else if constexpr (std::is_same_v<T, double>) {
+                eq = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)));
+            } else if constexpr (sizeof(T) == 1) {
+                eq = _mm_cmpeq_epi8(block, needle);
+            } else if constexpr (sizeof(T) == 2) {
+                eq = _mm_cmpeq_epi16(block, needle);
+            } else if constexpr (sizeof(T) == 4) {
+                eq = _mm_cmpeq_epi32(block, needle);
+            } else {
+                // SSE2 has no 64-bit compare; both 32-bit halves must match
+                eq = _mm_cmpeq_epi32(block, needle);
+                eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+            unsigned mask = (unsigned)_mm_movemask_epi8(eq) & laneBits(sizeof(T));
+            if (mask != 0) {
+                if (mode == first) {
+                    return i + std::countr_zero(mask) / (int)sizeof(T);
+                }
+                matches = report(mask, i, sizeof(T), mode, out, offset, matches);
+            }
+        }
+        return finish(arr, n, e, mode, out, offset, i, matches);
+    }
+
+    /**
+     * @brief AVX2 kernel comparing 32 bytes per step
+     */
+    template <typename T> __attribute__((target("avx2")))
+    static int scanAVX2(const T *arr, int n, const T &e, searchMode mode, std::vector<int> *out, int offset) {
+        constexpr int lanes = 32 / sizeof(T);
+        T repeated[lanes];
+        std::fill_n(repeated, lanes, e);
+        __m256i needle = _mm256_loadu_si256((const __m256i *)repeated);
+
+        int matches = 0, i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            __m256i block = _mm256_loadu_si256((const __m256i *)(arr + i)), eq;
+            if constexpr (std::is_same_v<T, float>) {
+                eq = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(block), _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+            } else if constexpr (std::is_same_v<T, double>) {
+                eq = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(block), _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+            } else if constexpr (sizeof(T) == 1) {
+                eq = _mm256_cmpeq_epi8(block, needle);
+            } else if constexpr (sizeof(T) == 2) {
+                eq = _mm256_cmpeq_epi16(block, needle);
+            } else if constexpr (sizeof(T) == 4) {
+                eq = _mm256_cmpeq_epi32(block, needle);
+            } else {
+                eq = _mm256_cmpeq_epi64(block, needle);
+            }
+            unsigned mask = (unsigned)_mm256_movemask_epi8(eq) & laneBits(sizeof(T));
+            if (mask != 0) {
+                if (mode == first) {
+                    return i + std::countr_zero(mask) / (int)sizeof(T);
+                }
+                matches = report(mask, i, sizeof(T), mode, out, offset, matches);
+            }
+        }
+        return finish(arr, n, e, mode, out, offset, i, matches);
+    }
+#endif
+
+    private:
+
+    /**
+     * @brief Returns a byte mask with one bit set at the first byte of every element of the given size
+     */
+    static constexpr unsigned laneBits(int elementSize) {
+        unsigned bits = 0;
+        for (int i = 0; i < 32; i += elementSize) {
+            bits |= 1u << i;
+        }
+        return bits;
+    }
+
+    /**
+     * @brief Records the matches of one vector in mode count or all and returns the updated match count
+     */
+    static int report(unsigned mask, int base, int elementSize, searchMode mode, std::vector<int> *out, int offset, int matches) {
+        if (mode == count) {
+            return matches + std::popcount(mask);
+        }
+        for (; mask != 0; mask &= mask - 1) {
+            out->push_back(offset + base + std::countr_zero(mask) / elementSize);
+            matches++;
+        }
+        return matches;
+    }
+
+    /**
+     * @brief Scans the elements after the last full vector and combines the result with the vector matches
+     */
+    template <typename T>
+    static int finish(const T *arr, int n, const T &e, searchMode mode, std::vector<int> *out, int offset, int from, int matches) {
+        int rest = scanScalar(arr, n, e, mode, out, offset, from);
+        return mode == first ? rest : matches + rest;
+    }
+};
+
+/**
+ * @brief Capacity policy that wraps indices with the modulo operator
+ * 
+ * @details Any capacity is valid. This is the default policy of the circular dynamic array.
+ */
+struct ModuloCapacity {
+    /**
+     * @brief Wraps a non-negative index into the range [0, cap)
+     */
+    static int wrap(int i, int cap) { return i % cap; }
+
+    /**
+     * @brief Returns the capacity used to hold n elements
+     */
+    static constexpr int fit(int n) { return n; }
+};
+
+/**
+ * @brief Capacity policy that keeps the capacity a power of two
+ * 
+ * @details Indices are wrapped with a bitmask instead of an integer division, which is considerably cheaper on every access.
+ *          Requested capacities are rounded up to the next power of two, up to 2^30.
+ */
+struct PowerOfTwoCapacity {
+    /**
+     * @brief Wraps an index into the range [0, cap) with a bitmask. Also valid for i = -1.
+     */
+    static int wrap(int i, int cap) { return i & (cap - 1); }
+
+    /**
+     * @brief The largest capacity, the largest power of two an int holds
+     */
+    static constexpr int maxCapacity = 1 << 30;
+
+    /**
+     * @brief Returns the smallest power of two that holds n elements
+     * 
+     * @details Throws std::length_error if n > maxCapacity (2^30), since the next power of two does not fit in an int.
+     */
+    static constexpr int fit(int n) {
+        if (n > maxCapacity) {
+            throw std::length_error("PowerOfTwoCapacity: capacity above 2^30");
+        }
+        return n <= 1 ? 1 : (int)std::bit_ceil((unsigned)n);
+    }
+};
+
+/**
+ * @brief A monotonic arena that hands out memory by bumping a pointer through large chunks
+ * 
+ * @details Individual deallocations are ignored, except that freeing the most recent allocation gives its bytes back, which covers the
+ *          grow-and-free pattern of a dynamic array and short-lived scratch buffers. All memory is returned at once by reset() or the
+ *          destructor. Chunks grow geometrically; an optional caller supplied buffer (e.g. on the stack) is used first.
+ *          Not thread-safe: use one arena per thread or per request.
+ */
+class MonotonicArena {
+
+    public:
+
+    /**
+     * @brief Constructs an empty arena
+     * 
+     * @param chunkSize The size in bytes of the first chunk taken from the global heap
+     */
+    MonotonicArena(std::size_t chunkSize = 64 * 1024) : nextChunkSize(std::max<std::size_t>(chunkSize, 256)) {}
+
+    /**
+     * @brief Constructs an arena that serves allocations from buffer until it is exhausted
+     * 
+     * @param buffer Storage owned by the caller that outlives the arena
+     * @param bytes The size of buffer in bytes
+     * @param chunkSize The size in bytes of the first chunk taken from the global heap
+     */
+    MonotonicArena(void *buffer, std::size_t bytes, std::size_t chunkSize = 64 * 1024) : MonotonicArena(chunkSize) {
+        initial = (char *)buffer;
+        initialEnd = initial + bytes;
+        cursor = initial;
+        limit = initialEnd;
+    }
+
+    MonotonicArena(const MonotonicArena &) = delete;
+    MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+    /**
+     * @brief Destructor. Frees every chunk.
+     */
+    ~MonotonicArena() { freeChunks(nullptr); }
+
+    /**
+     * @brief Returns bytes of storage aligned to align
+     * 
+     * @details Time complexity: O(1)
+     */
+    void *allocate(std::size_t bytes, std::size_t align) {
+        char *p = alignUp(cursor, align);
+        // Aligning can move p past limit, so that must be checked before limit - p is taken as a size
+        if (p == nullptr || p > limit || bytes > (std::size_t)(limit - p)) {
+            grow(bytes + align);
+            p = alignUp(cursor, align);
+        }
+        cursor = p + bytes;
+        return p;
+    }
+
+    /**
+     * @brief Gives the bytes back if p was the most recent allocation, otherwise does nothing
+     * 
+     * @details Time complexity: O(1)
+     */
+    void deallocate(void *p, std::size_t bytes) {
+        if ((char *)p + bytes == cursor) {
+            cursor = (char *)p;
+        }
+    }
+
+    /**
+     * @brief Invalidates every allocation and makes the memory available again
+     * 
+     * @details Keeps the most recent (largest) chunk for reuse and frees the others. Time complexity: O(number of chunks)
+     */
+    void reset() {
+        freeChunks(chunks);
+        if (chunks != nullptr) {
+            chunks->next = nullptr;
+            cursor = chunkData(chunks);
+            limit = cursor + chunks->size;
+        } else {
+            cursor = initial;
+            limit = initialEnd;
+        }
+    }
+
+    private:
+
+    /**
+     * @brief Header at the start of every chunk taken from the global heap
+     */
+    struct Chunk {
+        Chunk *next;
+        std::size_t size;
+    };
+
+    /**
+     * @brief The most recent chunk, linked to the older ones
+     */
+    Chunk *chunks = nullptr;
+
+    /**
+     * @brief The next free byte and the end of the current chunk
+     */
+    char *cursor = nullptr;
+    char *limit = nullptr;
+
+    /**
+     * @brief The caller supplied buffer, if any
+     */
+    char *initial = nullptr;
+    char *initialEnd = nullptr;
+
+    /**
+     * @brief The size in bytes of the next chunk
+     */
+    std::size_t nextChunkSize;
+
+    /**
+     * @brief Rounds p up to a multiple of align, or returns nullptr if there is no current chunk
+     */
+    static char *alignUp(char *p, std::size_t align) {
+        if (p == nullptr) {
+            return nullptr;
+        }
+        return (char *)(((std::uintptr_t)p + align - 1) & ~(std::uintptr_t)(align - 1));
+    }
+
+    /**
+     * @brief Returns the first usable byte of a chunk
+     */
+    static char *chunkData(Chunk *c) { return (char *)c + sizeof(Chunk); }
+
+    /**
+     * @brief Starts a new chunk that holds at least bytes
+     */
+    void grow(std::size_t bytes) {
+        std::size_t size = std::max(nextChunkSize, bytes);
+        Chunk *c = (Chunk *)::operator new(sizeof(Chunk) + size);
+        c->next = chunks;
+        c->size = size;
+        chunks = c;
+        cursor = chunkData(c);
+        limit = cursor + size;
+        nextChunkSize = std::max(nextChunkSize, size) * 2;
+    }
+
+    /**
+     * @brief Frees the chunks older than keep, or all chunks if keep is nullptr
+     */
+    void freeChunks(Chunk *keep) {
+        Chunk *c = keep != nullptr ? keep->next : chunks;
+        while (c != nullptr) {
+            Chunk *next = c->next;
+            ::operator delete(c);
+            c = next;
+        }
+    }
+};
+
+/**
+ * @brief Standard allocator that carves memory out of a MonotonicArena
+ * 
+ * @details Copies share the arena and compare equal when they refer to the same arena. The arena must outlive every container using it.
+ * 
+ * @tparam T The type of element allocated
+ */
+template <typename T> class ArenaAllocator {
+
+    public:
+
+    using value_type = T;
+
+    /**
+     * @brief Constructs an allocator that uses arena
+     */
+    ArenaAllocator(MonotonicArena &arena) noexcept : arena(&arena) {}
+
+    /**
+     * @brief Converting constructor used when rebinding to another element type
+     */
+    template <typename U> ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena(other.arena) {}
+
+    /**
+     * @brief Allocates uninitialized storage for n elements
+     */
+    T *allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return (T *)arena->allocate(n * sizeof(T), alignof(T));
+    }
+
+    /**
+     * @brief Frees storage obtained from allocate (see MonotonicArena::deallocate)
+     */
+    void deallocate(T *p, std::size_t n) noexcept { arena->deallocate(p, n * sizeof(T)); }
+
+    template <typename U> bool operator==(const ArenaAllocator<U> &other) const noexcept { return arena == other.arena; }
+
+    /**
+     * @brief The arena the memory comes from
+     */
+    MonotonicArena *arena;
+};
+
+/**
+ * @brief Standard allocator that aligns every allocation to a cache line
+ * 
+ * @details Used where the position of elements relative to cache line boundaries matters, such as the child groups of a d-ary Heap.
+ * 
+ * @tparam T The type of element allocated
+ */
+template <typename T> class CacheAlignedAllocator {
+
+    public:
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    CacheAlignedAllocator() noexcept = default;
+
+    /**
+     * @brief Converting constructor used when rebinding to another element type
+     */
+    template <typename U> CacheAlignedAllocator(const CacheAlignedAllocator<U> &) noexcept {}
+
+    /**
+     * @brief Allocates uninitialized storage for n elements
+     */
+    T *allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return (T *)::operator new(n * sizeof(T), std::align_val_t(alignment));
+    }
+
+    /**
+     * @brief Frees storage obtained from allocate
+     */
+    void deallocate(T *p, std::size_t) noexcept { ::operator delete(p, std::align_val_t(alignment)); }
+
+    template <typename U> bool operator==(const CacheAlignedAllocator<U> &) const noexcept { return true; }
+
+    private:
+
+    static constexpr std::size_t alignment = std::max(cacheLineSize, alignof(T));
+};
+
+/**
+ * @brief Standard allocator that backs large allocations with huge pages
+ * 
+ * @details Allocations of at least hugePageSize bytes are mapped with mmap, aligned to hugePageSize and rounded up to a multiple of it.
+ *          Explicit huge pages (MAP_HUGETLB) are tried first; if none are reserved the mapping falls back to regular pages with
+ *          transparent huge pages requested through madvise. Either way a large array needs far fewer TLB entries. Smaller allocations,
+ *          and all allocations on platforms other than Linux, use the global heap.
+ * 
+ * @tparam T The type of element allocated
+ */
+template <typename T> class HugePageAllocator {
+
+    public:
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    /**
+     * @brief The huge page size assumed for alignment and rounding, 2 MiB on x86-64 and most AArch64 kernels
+     */
+    static constexpr std::size_t hugePageSize = std::size_t(2) << 20;
+
+    HugePageAllocator() noexcept = default;
+
+    /**
+     * @brief Converting constructor used when rebinding to another element type
+     */
+    template <typename U> HugePageAllocator(const HugePageAllocator<U> &) noexcept {}
+
+    /**
+     * @brief Allocates uninitialized storage for n elements
+     */
+    T *allocate(std::size_t n) {
+        if (n > (std::numeric_limits<std::size_t>::max() - 2 * hugePageSize) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+#if defined(__linux__)
+        std::size_t bytes = n * sizeof(T);
+        if (bytes >= hugePageSize) {
+            return (T *)mapHuge(roundUp(bytes));
+        }
+#endif
+        return std::allocator<T>().allocate(n);
+    }
+
+    /**
+     * @brief Frees storage obtained from allocate
+     */
+    void deallocate(T *p, std::size_t n) noexcept {
+#if defined(__linux__)
+        std::size_t bytes = n * sizeof(T);
+        if (bytes >= hugePageSize) {
+            munmap(p, roundUp(bytes));
+            return;
+        }
+#endif
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U> bool operator==(const HugePageAllocator<U> &) const noexcept { return true; }
+
+    private:
+
+    /**
+     * @brief Rounds bytes up to a multiple of hugePageSize
+     */
+    static std::size_t roundUp(std::size_t bytes) { return (bytes + hugePageSize - 1) & ~(hugePageSize - 1); }
+
+#if defined(__linux__)
+    /**
+     * @brief Maps len bytes, a multiple of hugePageSize, aligned to hugePageSize
+     */
+    static void *mapHuge(std::size_t len) {
+#ifdef MAP_HUGETLB
+        void *p = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            return p;
+        }
+#else
+        void *p;
+#endif
+
+        // Over-map by one huge page and trim both ends so the kernel can back the range with transparent huge pages
+        p = mmap(nullptr, len + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        char *raw = (char *)p;
+        char *aligned = (char *)(((std::uintptr_t)raw + hugePageSize - 1) & ~(std::uintptr_t)(hugePageSize - 1));
+        if (aligned != raw) {
+            munmap(raw, aligned - raw);
+        }
+        std::size_t tail = (raw + len + hugePageSize) - (aligned + len);
+        if (tail != 0) {
+            munmap(aligned + len, tail);
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(aligned, len, MADV_HUGEPAGE);
+#endif
+        return aligned;
+    }
+#endif
+};
 
 /**
  * @brief Implements a circular dynamic array that can dynamically resize itself
  * 
- * @tparam elmtype The type of element stored in the circular dynamic array
+ * @tparam elmtype The type of element stored in the circular dynamic array
+ * @tparam capPolicy The capacity policy, either ModuloCapacity (default) or PowerOfTwoCapacity
+ * @tparam Alloc The allocator for the storage and scratch buffers, e.g. std::allocator (default), ArenaAllocator, HugePageAllocator or
+ *               std::pmr::polymorphic_allocator. Elements are constructed in place directly, without uses-allocator construction.
+ * @tparam inlineCap The number of elements stored inside the array object itself (0 by default). Arrays that never hold more than
+ *                   this many elements never call the allocator; see SmallCircularDynamicArray.
+ */
+template <typename elmtype, typename capPolicy = ModuloCapacity, typename Alloc = std::allocator<elmtype>, int inlineCap = 0>
+class CircularDynamicArray {
+
+    static_assert(std::is_same_v<typename std::allocator_traits<Alloc>::value_type, elmtype>, "Alloc must allocate elmtype");
+    static_assert(std::is_same_v<typename std::allocator_traits<Alloc>::pointer, elmtype *>, "Alloc must use raw pointers");
+
+   public:
+    /**
+     * @brief Random access iterator over the live elements of the array
+     * 
+     * @details The iterator walks the two contiguous segments returned by segments(), so dereferencing only needs a comparison
+     *          instead of a modulo. It is invalidated by any operation that adds or removes elements.
+     * 
+     * @tparam valType elmtype for a mutable iterator, const elmtype for a constant iterator
+     */
+    template <typename valType> class SegmentIterator {
+       public:
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<valType>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = valType *;
+        using reference = valType &;
+
+        SegmentIterator() : head(nullptr), tail(nullptr), headLen(0), idx(0) {}
+
+        SegmentIterator(valType *h, difference_type hLen, valType *t, difference_type i) : head(h), tail(t), headLen(hLen), idx(i) {}
+
+        /**
+         * @brief Converts a mutable iterator to a constant iterator
+         */
+        operator SegmentIterator<const valType>() const requires(!std::is_const_v<valType>) { return SegmentIterator<const valType>(head, headLen, tail, idx); }
+
+        reference operator*() const { return idx < headLen ? head[idx] : tail[idx - headLen]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        SegmentIterator &operator++() { idx++; return *this; }
+        SegmentIterator operator++(int) { SegmentIterator temp = *this; idx++; return temp; }
+        SegmentIterator &operator--() { idx--; return *this; }
+        SegmentIterator operator--(int) { SegmentIterator temp = *this; idx--; return temp; }
+        SegmentIterator &operator+=(difference_type n) { idx += n; return *this; }
+        SegmentIterator &operator-=(difference_type n) { idx -= n; return *this; }
+
+        friend SegmentIterator operator+(SegmentIterator it, difference_type n) { return it += n; }
+        friend SegmentIterator operator+(difference_type n, SegmentIterator it) { return it += n; }
+        friend SegmentIterator operator-(SegmentIterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const SegmentIterator &a, const SegmentIterator &b) { return a.idx - b.idx; }
+        friend bool operator==(const SegmentIterator &a, const SegmentIterator &b) { return a.idx == b.idx; }
+        friend auto operator<=>(const SegmentIterator &a, const SegmentIterator &b) { return a.idx <=> b.idx; }
+
+       private:
+        /**
+         * @brief The first segment, starting at the logical index 0
+         */
+        valType *head;
+
+        /**
+         * @brief The wrapped segment, starting at the logical index headLen
+         */
+        valType *tail;
+
+        /**
+         * @brief The length of the first segment
+         */
+        difference_type headLen;
+
+        /**
+         * @brief The logical index of the iterator
+         */
+        difference_type idx;
+    };
+
+    using iterator = SegmentIterator<elmtype>;
+    using const_iterator = SegmentIterator<const elmtype>;
+    using allocator_type = Alloc;
+
+    /**
+     * @brief Default Constructor
+     * 
+     * @details Initializes the circular dynamic array with a capacity of 2, or the inline capacity if there is one. Finish is set to the slot
+     *          before start for addEnd() and addFront() functionality. Storage is left uninitialized; elements are only constructed when they are added.
+     */
+    CircularDynamicArray() : CircularDynamicArray(Alloc()) {}
+
+    /**
+     * @brief Constructs an empty array that takes its storage from an allocator
+     * 
+     * @details See the default constructor
+     * 
+     * @param alloc The allocator, copied into the array
+     */
+    explicit CircularDynamicArray(const Alloc &alloc) : alloc(alloc) {
+        cap = defaultCap;
+        size = 0;
+        start = 0;
+        finish = tail();
+        info = allocate(cap);
+    }
+
+    /**
+     * @brief Constructor for a set capacity
+     * 
+     * @details Initializes the circular dynamic array with a set capacity. Finish is set to the last element for addEnd() and addFront() functionality.
+     *          The capacity is rounded up as required by the capacity policy, and to at least the default capacity so an empty array
+     *          has storage. All capacity elements are default constructed.
+     * 
+     * @param capacity The capacity of the circular dynamic array
+     * @param alloc The allocator, copied into the array
+     */
+    CircularDynamicArray(int capacity, const Alloc &alloc = Alloc()) : alloc(alloc) {
+        cap = capPolicy::fit(std::max(capacity, defaultCap));
+        size = capacity;
+        start = 0;
+        finish = tail();
+        info = allocate(cap);
+        std::uninitialized_default_construct_n(info, size);
+    };
+
+    /**
+     * @brief Copy constructor (deep copy)
+     * 
+     * @details Deep copies all live values from the source circular dynamic array. The copy starts at index 0 of its storage.
+     *          The allocator is obtained with select_on_container_copy_construction.
+     * 
+     * @param src The source circular dynamic array to copy
+     */
+    CircularDynamicArray(CircularDynamicArray const &src) : alloc(allocTraits::select_on_container_copy_construction(src.alloc)) {
+        copyFrom(src);
+    }
+
+    /**
+     * @brief Move constructor
+     * 
+     * @details Takes ownership of the source storage. The source keeps a copy of the allocator and is left empty with its default
+     *          capacity. Elements held in the source's inline buffer are moved one by one instead.
+     * 
+     * @param src The source circular dynamic array to move from
+     */
+    CircularDynamicArray(CircularDynamicArray &&src) : alloc(src.alloc) {
+        if (src.isInline(src.info)) {
+            copyFrom(std::move(src));
+            src.clear();
+            return;
+        }
+        cap = src.cap;
+        size = src.size;
+        start = src.start;
+        finish = src.finish;
+        info = src.info;
+        growthFactor = src.growthFactor;
+        shrinkThreshold = src.shrinkThreshold;
+        reserved = src.reserved;
+        src.reserved = 0;
+        src.cap = defaultCap;
+        src.size = 0;
+        src.start = 0;
+        src.finish = src.tail();
+        src.info = src.allocate(defaultCap);
+    }
+    
+    /**
+     * @brief Destructor
+     * 
+     * @details Destroys the live elements and frees the array data
+     */
+    ~CircularDynamicArray() { release(); };
+
+    /**
+     * @brief Returns the size of the array
+     */
+    int length() { return size; }
+
+    /**
+     * @brief Returns the capacity of the array
+     */
+    int capacity() { return cap; }
+
+    /**
+     * @brief Returns a copy of the allocator
+     */
+    Alloc get_allocator() const { return alloc; }
+
+    /**
+     * @brief Returns the live elements as at most two contiguous spans
+     * 
+     * @details The first span starts at index 0 and runs up to the physical end of the storage; the second span holds the elements that
+     *          wrapped around to the physical start and is empty if the array does not wrap. The spans can be handed directly to write(),
+     *          SIMD kernels or standard algorithms. They are invalidated by any operation that adds or removes elements. Time complexity: O(1)
+     * 
+     * @return The head segment and the wrapped tail segment
+     */
+    std::pair<std::span<elmtype>, std::span<elmtype>> segments() {
+        int headLen = std::min(size, cap - start);
+        return {std::span<elmtype>(info + start, headLen), std::span<elmtype>(info, size - headLen)};
+    }
+
+    /**
+     * @brief Returns the live elements as at most two contiguous read-only spans
+     * 
+     * @details See segments(). Time complexity: O(1)
+     */
+    std::pair<std::span<const elmtype>, std::span<const elmtype>> segments() const {
+        int headLen = std::min(size, cap - start);
+        return {std::span<const elmtype>(info + start, headLen), std::span<const elmtype>(info, size - headLen)};
+    }
+
+    /**
+     * @brief Returns an iterator to the first element
+     */
+    iterator begin() { return makeIterator<elmtype>(info, 0); }
+
+    /**
+     * @brief Returns an iterator past the last element
+     */
+    iterator end() { return makeIterator<elmtype>(info, size); }
+
+    /**
+     * @brief Returns a constant iterator to the first element
+     */
+    const_iterator begin() const { return makeIterator<const elmtype>(info, 0); }
+
+    /**
+     * @brief Returns a constant iterator past the last element
+     */
+    const_iterator end() const { return makeIterator<const elmtype>(info, size); }
+    
+    /**
+     * @brief Returns the value of the element at index i
+     */
+    elmtype atRef(int i) {
+        if (i < 0 || i >= size) {
+            return burner;
+        }
+        return info[wrap(i + start)];
+    }
+    
+    /**
+     * @brief Returns a pointer to the element at index i
+     */
+    elmtype *atPoint(int i) {
+        if (i < 0 || i >= size) {
+            return &burner;
+        }
+        return &info[wrap(i + start)];
+    }
+
+    /**
+     * @brief Bracket operator. Returns burner element if index is invalid.
+     */
+    elmtype &operator[](int i) {
+        if (i < 0 || i >= size) {
+            return burner;
+        }
+        return info[wrap(i + start)];
+    }
+
+    /**
+     * @brief Equals operator. Deep copies all live values.
+     * 
+     * @details The allocator is copied as well if it propagates on copy assignment.
+     */
+    CircularDynamicArray &operator=(const CircularDynamicArray &R) {
+        if (this == &R) {
+            return *this;
+        }
+        release();
+        if constexpr (allocTraits::propagate_on_container_copy_assignment::value) {
+            alloc = R.alloc;
+        }
+        copyFrom(R);
+        return *this;
+    }
+
+    /**
+     * @brief Move equals operator. Swaps storage with the source array.
+     * 
+     * @details If the allocators differ and do not propagate on move assignment, or either array uses its inline buffer, the storage
+     *          cannot change hands and the elements are moved one by one into this array's storage instead.
+     */
+    CircularDynamicArray &operator=(CircularDynamicArray &&R) {
+        if (this == &R) {
+            return *this;
+        }
+        if (isInline(info) || R.isInline(R.info)) {
+            release();
+            copyFrom(std::move(R));
+            return *this;
+        }
+        if constexpr (!allocTraits::propagate_on_container_move_assignment::value && !allocTraits::is_always_equal::value) {
+            if (!(alloc == R.alloc)) {
+                release();
+                copyFrom(std::move(R));
+                return *this;
+            }
+        }
+        if constexpr (allocTraits::propagate_on_container_move_assignment::value) {
+            std::swap(alloc, R.alloc);
+        }
+        std::swap(cap, R.cap);
+        std::swap(size, R.size);
+        std::swap(start, R.start);
+        std::swap(finish, R.finish);
+        std::swap(info, R.info);
+        std::swap(growthFactor, R.growthFactor);
+        std::swap(shrinkThreshold, R.shrinkThreshold);
+        std::swap(reserved, R.reserved);
+        return *this;
+    }
+
+    /**
+     * @brief Adds a copy of an element to the front of the array
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     */
+    void addFront(const elmtype &v) { emplaceFront(v); };
+
+    /**
+     * @brief Moves an element to the front of the array
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     */
+    void addFront(elmtype &&v) { emplaceFront(std::move(v)); };
+
+    /**
+     * @brief Adds a copy of an element to the end of the array
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     */
+    void addEnd(const elmtype &v) { emplaceEnd(v); }
+
+    /**
+     * @brief Moves an element to the end of the array
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     */
+    void addEnd(elmtype &&v) { emplaceEnd(std::move(v)); }
+
+    /**
+     * @brief Constructs an element in place at the front of the array
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     * 
+     * @param args The arguments forwarded to the element constructor
+     * 
+     * @return A reference to the new element
+     */
+    template <typename... Args> elmtype &emplaceFront(Args &&...args) {
+        if (size == cap) {
+            // The arguments may refer to an element of this array, so build the value before the storage moves
+            elmtype v(std::forward<Args>(args)...);
+            checkCapIncrease();
+            return emplaceFront(std::move(v));
+        }
+        int pos = (start > 0) ? start - 1 : cap - 1;
+        ::new ((void *)(info + pos)) elmtype(std::forward<Args>(args)...);
+        start = pos;
+        size++;
+        return info[pos];
+    }
+
+    /**
+     * @brief Constructs an element in place at the end of the array
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     * 
+     * @param args The arguments forwarded to the element constructor
+     * 
+     * @return A reference to the new element
+     */
+    template <typename... Args> elmtype &emplaceEnd(Args &&...args) {
+        if (size == cap) {
+            // The arguments may refer to an element of this array, so build the value before the storage moves
+            elmtype v(std::forward<Args>(args)...);
+            checkCapIncrease();
+            return emplaceEnd(std::move(v));
+        }
+        int pos = wrap(finish + 1);
+        ::new ((void *)(info + pos)) elmtype(std::forward<Args>(args)...);
+        finish = pos;
+        size++;
+        return info[pos];
+    }
+
+    /**
+     * @brief Adds the elements of [first, last) to the end of the array, keeping their order
+     * 
+     * @details Forward ranges reserve the final capacity once and are copied in at most two contiguous segments around the wrap point.
+     *          Contiguous ranges of trivially copyable elements are copied with memcpy. Input-only ranges fall back to emplaceEnd.
+     *          The range must not refer to elements of this array. Time complexity: O(n), n = number of added elements
+     * 
+     * @param first The iterator to the first element to add
+     * @param last The iterator past the last element to add
+     */
+    template <typename InputIt> void appendRange(InputIt first, InputIt last) {
+        if constexpr (!std::forward_iterator<InputIt>) {
+            for (; first != last; ++first) {
+                emplaceEnd(*first);
+            }
+        } else {
+            int n = (int)std::distance(first, last);
+            if (n <= 0) {
+                return;
+            }
+            growFor(size + n);
+            copySegments(first, last, n, wrap(finish + 1));
+            finish = wrap(finish + n);
+            size += n;
+        }
+    }
+
+    /**
+     * @brief Adds the elements of a span to the end of the array, keeping their order
+     * 
+     * @details See appendRange(first, last). Time complexity: O(n), n = s.size()
+     */
+    void appendRange(std::span<const elmtype> s) { appendRange(s.begin(), s.end()); }
+
+    /**
+     * @brief Adds the elements of [first, last) to the front of the array, keeping their order
+     * 
+     * @details After the call, the first element of the range is at index 0. Forward ranges reserve the final capacity once and are copied in
+     *          at most two contiguous segments around the wrap point. Contiguous ranges of trivially copyable elements are copied with memcpy.
+     *          The range must not refer to elements of this array. Time complexity: O(n), n = number of added elements
+     * 
+     * @param first The iterator to the first element to add
+     * @param last The iterator past the last element to add
+     */
+    template <typename InputIt> void prependRange(InputIt first, InputIt last) {
+        if constexpr (!std::forward_iterator<InputIt>) {
+            // Single pass ranges are buffered so that their order is kept
+            CircularDynamicArray buffer(alloc);
+            for (; first != last; ++first) {
+                buffer.emplaceEnd(*first);
+            }
+            for (int i = buffer.length() - 1; i >= 0; i--) {
+                emplaceFront(std::move(buffer[i]));
+            }
+        } else {
+            int n = (int)std::distance(first, last);
+            if (n <= 0) {
+                return;
+            }
+            growFor(size + n);
+            int pos = start - n;
+            if (pos < 0) {
+                pos += cap;
+            }
+            copySegments(first, last, n, pos);
+            start = pos;
+            size += n;
+        }
+    }
+
+    /**
+     * @brief Adds the elements of a span to the front of the array, keeping their order
+     * 
+     * @details See prependRange(first, last). Time complexity: O(n), n = s.size()
+     */
+    void prependRange(std::span<const elmtype> s) { prependRange(s.begin(), s.end()); }
+
+    /**
+     * @brief Removes the element at the front of the array
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     */
+    void delFront() {
+        if (size == 0) {
+            return;
+        }
+        std::destroy_at(info + start);
+        start = wrap(start + 1);
+        size--;
+        checkCapDecrease();
+    };
+
+    /**
+     * @brief Removes the element at the end of the array
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     */
+    void delEnd() {
+        if (size == 0) {
+            return;
+        }
+        std::destroy_at(info + finish);
+        finish--;
+        if (finish == -1) {
+            finish = cap - 1;
+        }
+        size--;
+        checkCapDecrease();
+    };
+
+    /**
+     * @brief Removes the first n elements of the array
+     * 
+     * @details Removes all elements if n >= length(). The capacity is checked once, after all elements are removed.
+     *          Time complexity: O(1) for trivially destructible elements, O(n) otherwise (plus O(size) if the array shrinks)
+     * 
+     * @param n The number of elements to remove
+     */
+    void delFront(int n) {
+        n = std::clamp(n, 0, size);
+        if constexpr (!std::is_trivially_destructible_v<elmtype>) {
+            for (int i = 0; i < n; i++) {
+                std::destroy_at(info + wrap(start + i));
+            }
+        }
+        start = wrap(start + n);
+        size -= n;
+        checkCapDecrease();
+    }
+
+    /**
+     * @brief Removes the last n elements of the array
+     * 
+     * @details Removes all elements if n >= length(). The capacity is checked once, after all elements are removed.
+     *          Time complexity: O(1) for trivially destructible elements, O(n) otherwise (plus O(size) if the array shrinks)
+     * 
+     * @param n The number of elements to remove
+     */
+    void delEnd(int n) {
+        n = std::clamp(n, 0, size);
+        if constexpr (!std::is_trivially_destructible_v<elmtype>) {
+            for (int i = size - n; i < size; i++) {
+                std::destroy_at(info + wrap(start + i));
+            }
+        }
+        size -= n;
+        finish = tail();
+        checkCapDecrease();
+    }
+
+    /**
+     * @brief Makes room for at least n elements without further resizing
+     * 
+     * @details The array does not shrink below the reserved capacity on its own until shrinkToFit() is called.
+     *          Time complexity: O(size) if the array is resized, O(1) otherwise
+     * 
+     * @param n The number of elements to reserve room for
+     */
+    void reserve(int n) {
+        if (n > cap) {
+            relocate(capPolicy::fit(n));
+        }
+        reserved = std::max(reserved, n);
+    }
+
+    /**
+     * @brief Reduces the capacity to the smallest the capacity policy allows for the current size (at least the default capacity)
+     * 
+     * @details Also drops the floor set by reserve(). Moves the elements back into the inline buffer if they fit.
+     *          Time complexity: O(size) if the array is resized, O(1) otherwise
+     */
+    void shrinkToFit() {
+        reserved = 0;
+        int newCap = capPolicy::fit(std::max(size, defaultCap));
+        if (newCap < cap) {
+            relocate(newCap);
+        }
+    }
+
+    /**
+     * @brief Sets the factor the capacity is multiplied by when the array grows
+     * 
+     * @details The default is 2. Factors below 1.25 are raised to 1.25. The capacity policy may round the result up further.
+     * 
+     * @param factor The growth factor
+     */
+    void setGrowthFactor(double factor) { growthFactor = std::max(factor, 1.25); }
+
+    /**
+     * @brief Sets the fraction of the capacity below which the array shrinks
+     * 
+     * @details When a removal leaves fewer than fraction * capacity() elements, the capacity is divided by the growth factor, as many
+     *          times as needed, in one resize. The default is 0.25; 0 disables automatic shrinking. The fraction is capped at
+     *          0.5 / growth factor so that at least half of the new capacity is free after a shrink, which keeps an array whose size
+     *          oscillates around the threshold from resizing back and forth.
+     * 
+     * @param fraction The shrink threshold as a fraction of the capacity
+     */
+    void setShrinkThreshold(double fraction) { shrinkThreshold = std::max(fraction, 0.0); }
+
+    /**
+     * @brief Clears all array data and resets the array to its default state
+     * 
+     * @details The growth factor and shrink threshold are kept; the reserved capacity is dropped.
+     */
+    void clear() {
+        release();
+        reserved = 0;
+        size = 0;
+        cap = defaultCap;
+        start = 0;
+        finish = tail();
+        info = allocate(cap);
+    };
+
+    /**
+     * @brief Swaps two elements
+     */
+    void swap(elmtype *a, elmtype *b) {
+        elmtype temp = std::move(*a);
+        (*a) = std::move(*b);
+        (*b) = std::move(temp);
+    }
+
+    /**
+     * @brief Returns the Kth smallest element of the array using a median of three as the partition element
+     * 
+     * @details Runs introselect: quickselect that falls back to median of medians pivots after 2 * lg(size) rounds, so the worst case stays linear.
+     *          By default the search runs on a heap allocated copy of the array; with inPlace set it reorders the array itself and needs no extra
+     *          memory. Time complexity: O(size)
+     * 
+     * @param k The index of the element to find
+     * @param inPlace Whether to partition the array itself instead of a copy
+     * 
+     * @return The Kth smallest element of the array
+     */
+    elmtype QuickSelect(int k, bool inPlace = false) {
+        if (k <= 0 || k > size) {
+            return burner;
+        }
+        return select(k, standard, inPlace);
+    }
+
+    /**
+     * @brief Returns the Kth smallest element of the array using the median of medians (subarray size = 5) as the partition element
+     * 
+     * @details By default the search runs on a heap allocated copy of the array; with inPlace set it reorders the array itself and needs no extra
+     *          memory. Time complexity: O(size)
+     * 
+     * @param k The index of the element to find
+     * @param inPlace Whether to partition the array itself instead of a copy
+     * 
+     * @return The Kth smallest element of the array
+     */
+    elmtype WCSelect(int k, bool inPlace = false) {
+        if (k <= 0 || k > size) {
+            return burner;
+        }
+        return select(k, worstCase, inPlace);
+    }
+
+    /**
+     * @brief Returns several order statistics of the array in one partitioning pass
+     * 
+     * @details Runs a multi-select: each partition step splits the requested ranks between both sides, so ranks share the work of the
+     *          partitions above them instead of repeating a full select per rank. Uses the same pivots and 2 * lg(size) fallback budget as
+     *          QuickSelect. Invalid ranks return the burner element. Time complexity: O(size * lg(m)), m = ks.size()
+     * 
+     * @param ks The 1-based ranks to find, in any order
+     * @param inPlace Whether to partition the array itself instead of a copy
+     * 
+     * @return The Kth smallest element for each rank in ks, in the order of ks
+     */
+    std::vector<elmtype> selectMany(std::span<const int> ks, bool inPlace = false) {
+        std::vector<int> targets;
+        for (int k : ks) {
+            if (k > 0 && k <= size) {
+                targets.push_back(k - 1);
+            }
+        }
+        std::sort(targets.begin(), targets.end());
+        targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+        std::vector<elmtype> result;
+        result.reserve(ks.size());
+        if (targets.empty()) {
+            result.assign(ks.size(), burner);
+            return result;
+        }
+
+        elmtype *arr = inPlace ? linearize() : linearCopy();
+        int budget = 0;
+        for (int n = size; n > 1; n >>= 1) {
+            budget += 2;
+        }
+        multiSelect(arr, 0, size - 1, targets.data(), 0, (int)targets.size() - 1, budget);
+
+        for (int k : ks) {
+            result.push_back((k > 0 && k <= size) ? arr[k - 1] : burner);
+        }
+        if (!inPlace) {
+            std::destroy_n(arr, size);
+            deallocate(arr, size);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the k smallest elements of the array in sorted order without changing the array
+     * 
+     * @details Selects the Kth smallest element on a copy, then sorts only the k elements in front of it. k is clamped to [0, size].
+     *          Time complexity: O(size + k * lg(k))
+     * 
+     * @param k The number of elements to return
+     * 
+     * @return The k smallest elements, sorted
+     */
+    std::vector<elmtype> topK(int k) {
+        k = std::clamp(k, 0, size);
+        std::vector<elmtype> result;
+        if (k == 0) {
+            return result;
+        }
+
+        elmtype *arr = linearCopy();
+        introSelect(arr, 0, size - 1, k - 1, standard);
+        sortPrefix(arr, k);
+        result.assign(std::make_move_iterator(arr), std::make_move_iterator(arr + k));
+        std::destroy_n(arr, size);
+        deallocate(arr, size);
+        return result;
+    }
+
+    /**
+     * @brief Rearranges the array so that its first k elements are the k smallest, in sorted order
+     * 
+     * @details The order of the remaining elements is unspecified. k is clamped to [0, size]. Time complexity: O(size + k * lg(k))
+     * 
+     * @param k The number of elements to sort into place
+     */
+    void partialSort(int k) {
+        k = std::clamp(k, 0, size);
+        if (k == 0) {
+            return;
+        }
+        elmtype *arr = linearize();
+        introSelect(arr, 0, size - 1, k - 1, standard);
+        sortPrefix(arr, k);
+    }
+
+    /**
+     * @brief Performs a stable mergesort on the array
+     * 
+     * @details The ring is linearized once, then sorted with a top-down mergesort that reuses a single scratch buffer of size / 2 elements.
+     *          Runs of up to insertionCutoff elements are sorted with insertion sort, and the upper levels of the merge tree are split
+     *          across worker threads. Only operator< is required. Time complexity: O(size * lg(size))
+     * 
+     * @param threads The maximum number of threads to use, 0 (default) uses the number of hardware threads
+     */
+    void stableSort(int threads = 0) {
+        if (size < 2) {
+            return;
+        }
+        if (threads <= 0) {
+            threads = (int)std::max(1u, std::thread::hardware_concurrency());
+        }
+        int depth = 0;
+        while ((2 << depth) <= threads) {
+            depth++;
+        }
+
+        elmtype *arr = linearize();
+        elmtype *buf = allocate(size / 2);
+        mergeSort(arr, size, buf, depth);
+        deallocate(buf, size / 2);
+    };
+
+    /**
+     * @brief Performs a stable LSD radix sort on an array of integral or floating-point elements
+     * 
+     * @details The ring is linearized once and sorted through a single scratch buffer of size elements. Keys are split into 11-bit digits
+     *          (8-bit for types of up to 2 bytes); signed values have their sign bit flipped and negative floating-point values have all
+     *          their bits flipped, so the digits sort in numeric order. All digit histograms are built in one pass, and passes whose digit
+     *          is the same for every element are skipped. For floating-point types -0.0 sorts before +0.0 and NaNs with the sign bit clear
+     *          sort after +infinity. Time complexity: O(size * sizeof(elmtype))
+     */
+    void radixSort() requires(std::is_arithmetic_v<elmtype> && sizeof(elmtype) <= 8 &&
+                              (std::is_integral_v<elmtype> || std::numeric_limits<elmtype>::is_iec559)) {
+        if (size < 2) {
+            return;
+        }
+
+        using keyType = radixKeyType;
+        constexpr int bits = sizeof(elmtype) * 8;
+        constexpr int digitBits = sizeof(elmtype) <= 2 ? 8 : 11;
+        constexpr int radix = 1 << digitBits;
+        constexpr int passes = (bits + digitBits - 1) / digitBits;
+        constexpr keyType digitMask = (keyType)(radix - 1);
+
+        elmtype *arr = linearize();
+        std::vector<int> counts(passes * radix, 0);
+        for (int i = 0; i < size; i++) {
+            keyType key = radixKey(arr[i]);
+            for (int p = 0; p < passes; p++) {
+                counts[p * radix + (int)((key >> (p * digitBits)) & digitMask)]++;
+            }
+        }
+
+        elmtype *buf = allocate(size);
+        elmtype *src = arr, *dst = buf;
+        for (int p = 0; p < passes; p++) {
+            int *count = &counts[p * radix];
+            keyType firstDigit = (radixKey(src[0]) >> (p * digitBits)) & digitMask;
+            if (count[firstDigit] == size) {
+                continue;
+            }
+
+            // Turn the histogram into starting offsets
+            for (int d = 0, sum = 0; d < radix; d++) {
+                int c = count[d];
+                count[d] = sum;
+                sum += c;
+            }
+            for (int i = 0; i < size; i++) {
+                dst[count[(int)((radixKey(src[i]) >> (p * digitBits)) & digitMask)]++] = src[i];
+            }
+            std::swap(src, dst);
+        }
+
+        if (src != arr) {
+            std::memcpy((void *)arr, (const void *)src, size * sizeof(elmtype));
+        }
+        deallocate(buf, size);
+    }
+
+    /**
+     * @brief Performs a linear search for element e
+     * 
+     * @details Scans the two contiguous segments directly; arithmetic elements are compared with SSE2/AVX2 kernels (see SimdSearch).
+     *          Time complexity: O(size)
+     * 
+     * @param e The element to search for
+     * 
+     * @return The index of the element if found, -1 otherwise
+     */
+    int linearSearch(const elmtype &e) {
+        auto [head, tail] = segments();
+        int i = SimdSearch::find(head.data(), (int)head.size(), e);
+        if (i >= 0) {
+            return i;
+        }
+        i = SimdSearch::find(tail.data(), (int)tail.size(), e);
+        return i >= 0 ? i + (int)head.size() : -1;
+    };
+
+    /**
+     * @brief Counts the elements equal to e
+     * 
+     * @details Uses the same kernels as linearSearch. Time complexity: O(size)
+     * 
+     * @param e The element to count
+     * 
+     * @return The number of elements equal to e
+     */
+    int count(const elmtype &e) {
+        auto [head, tail] = segments();
+        return SimdSearch::countOf(head.data(), (int)head.size(), e) + SimdSearch::countOf(tail.data(), (int)tail.size(), e);
+    }
+
+    /**
+     * @brief Returns the indices of all elements equal to e
+     * 
+     * @details Uses the same kernels as linearSearch. Time complexity: O(size)
+     * 
+     * @param e The element to search for
+     * 
+     * @return The matching indices in increasing order
+     */
+    std::vector<int> findAll(const elmtype &e) {
+        auto [head, tail] = segments();
+        std::vector<int> result;
+        SimdSearch::findAll(head.data(), (int)head.size(), e, result, 0);
+        SimdSearch::findAll(tail.data(), (int)tail.size(), e, result, (int)head.size());
+        return result;
+    }
+
+    /**
+     * @brief Returns the index of the first element that satisfies a predicate
+     * 
+     * @details Walks the two contiguous segments with plain pointers, so simple predicates can be auto-vectorized. Time complexity: O(size)
+     * 
+     * @param pred The predicate, called with a const reference to each element
+     * 
+     * @return The index of the first match, -1 otherwise
+     */
+    template <typename Pred> int findIf(Pred pred) {
+        auto [head, tail] = segments();
+        for (int i = 0; i < (int)head.size(); i++) {
+            if (pred(std::as_const(head[i]))) {
+                return i;
+            }
+        }
+        for (int i = 0; i < (int)tail.size(); i++) {
+            if (pred(std::as_const(tail[i]))) {
+                return i + (int)head.size();
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Finds the first element that is not less than e in a sorted array
+     * 
+     * @details Picks the segment that can hold the answer with one comparison and then runs a branchless binary search over it, so each
+     *          probe reads a plain pointer instead of branching through atRef. Only operator< is used.
+     *          Time complexity: O(lg(size))
+     * 
+     * @param e The element to search for
+     * 
+     * @return The index of the first element not less than e, or length() if there is none
+     */
+    int lowerBound(const elmtype &e) const {
+        auto [head, tail] = segments();
+        if (!tail.empty() && head.back() < e) {
+            return (int)head.size() + branchlessLowerBound(tail.data(), (int)tail.size(), e);
+        }
+        return branchlessLowerBound(head.data(), (int)head.size(), e);
+    }
+
+    /**
+     * @brief Performs a binary search for element e
+     * 
+     * @details The array must be sorted. Uses lowerBound. Time complexity: O(lg(size))
+     * 
+     * @param e The element to search for
+     * 
+     * @return The index of the first occurrence of the element if found, -1 otherwise
+     */
+    int binSearch(const elmtype &e) const {
+        int i = lowerBound(e);
+        return i < size && !(e < info[wrap(i + start)]) ? i : -1;
+    }
+
+   private:
+    // Array Data
+
+    /**
+     * @brief The capacity of the array
+     */
+    int cap;
+
+    /**
+     * @brief The size of the array
+     */
+    int size;
+
+    /**
+     * @brief The index of the first element in the array
+     */
+    int start;
+
+    /**
+     * @brief The index of the last element in the array
+     */
+    int finish;
+
+    /**
+     * @brief The array data, indexed by start and finish
+     */
+    elmtype *info;
+
+    /**
+     * @brief Burner element for error handling
+     */
+    elmtype burner = elmtype();
+
+    /**
+     * @brief The factor the capacity is multiplied by when the array grows, see setGrowthFactor
+     */
+    double growthFactor = 2.0;
+
+    /**
+     * @brief The fraction of the capacity below which the array shrinks, see setShrinkThreshold
+     */
+    double shrinkThreshold = 0.25;
+
+    /**
+     * @brief The capacity requested with reserve; the array does not shrink below it on its own
+     */
+    int reserved = 0;
+
+    /**
+     * @brief Returns the largest capacity up to inlineCap that the capacity policy accepts as is
+     */
+    static constexpr int largestInlineFit() {
+        int c = inlineCap;
+        while (c > 2 && capPolicy::fit(c) != c) {
+            c--;
+        }
+        return c;
+    }
+
+    /**
+     * @brief The capacity of an empty array: the inline capacity (as allowed by the capacity policy), or 2 without an inline buffer
+     */
+    static constexpr int defaultCap = inlineCap > 2 ? largestInlineFit() : 2;
+
+    /**
+     * @brief Storage for inlineCap elements inside the array object and whether it is handed out
+     */
+    struct InlineBuffer {
+        alignas(elmtype) unsigned char bytes[(inlineCap > 0 ? inlineCap : 1) * sizeof(elmtype)];
+        bool busy = false;
+    };
+
+    /**
+     * @brief Takes no space when there is no inline capacity
+     */
+    struct NoInlineBuffer {};
+
+    /**
+     * @brief The inline buffer
+     */
+    [[no_unique_address]] std::conditional_t<(inlineCap > 0), InlineBuffer, NoInlineBuffer> small;
+
+    using allocTraits = std::allocator_traits<Alloc>;
+
+    /**
+     * @brief The allocator for the array data and scratch buffers
+     */
+    [[no_unique_address]] Alloc alloc;
+
+    /**
+     * @brief The type of search to perform in the select function
+     * 
+     * @details standard uses the median as the partition element, worstCase uses the median of medians with subarray size 5
+     *          standard is faster for most cases, worstCase is faster for worst case scenarios
+     */
+    enum searchType { standard, worstCase };
+
+    /**
+     * @brief Wraps a physical index into the range [0, cap) using the capacity policy
+     */
+    int wrap(int i) const { return capPolicy::wrap(i, cap); }
+
+    /**
+     * @brief Returns the physical index of the last element, or the slot before start if the array is empty
+     * 
+     * @details finish is kept equal to this, so emplaceFront and prependRange leave it unchanged and the end operations stay in bounds
+     *          when they follow a front operation on an empty array.
+     */
+    int tail() const { return wrap(start + size - 1 + cap); }
+
+    /**
+     * @brief Used by lowerBound to search one contiguous sorted segment
+     * 
+     * @details Halves the range without a data-dependent branch: the comparison result scales the step added to the base, so the loop
+     *          runs exactly ceil(lg(n)) times and never mispredicts. Time complexity: O(lg(n))
+     * 
+     * @return The offset of the first element not less than e, or n if there is none
+     */
+    static int branchlessLowerBound(const elmtype *arr, int n, const elmtype &e) {
+        if (n == 0) {
+            return 0;
+        }
+        const elmtype *base = arr;
+        while (n > 1) {
+            int half = n / 2;
+            // Both candidates for the next probe are fetched while this one is compared
+            __builtin_prefetch(base + (n - half) / 2);
+            __builtin_prefetch(base + half + (n - half) / 2);
+            base += (base[half - 1] < e ? 1 : 0) * half;
+            n -= half;
+        }
+        return (int)(base - arr) + (*base < e ? 1 : 0);
+    }
+
+    /**
+     * @brief Builds an iterator at logical index i over the two segments of the storage
+     */
+    template <typename valType> SegmentIterator<valType> makeIterator(valType *base, int i) const {
+        int headLen = std::min(size, cap - start);
+        return SegmentIterator<valType>(base + start, headLen, base, i);
+    }
+
+    /**
+     * @brief Allocates uninitialized storage for n elements
+     * 
+     * @details Hands out the inline buffer if it is large enough and not in use, by the array data or by a scratch buffer.
+     */
+    elmtype *allocate(int n) {
+        if constexpr (inlineCap > 0) {
+            if (n <= inlineCap && !small.busy) {
+                small.busy = true;
+                return (elmtype *)small.bytes;
+            }
+        }
+        return allocTraits::allocate(alloc, n);
+    }
+
+    /**
+     * @brief Frees storage obtained from allocate. The elements must already be destroyed.
+     */
+    void deallocate(elmtype *p, int n) {
+        if constexpr (inlineCap > 0) {
+            if (isInline(p)) {
+                small.busy = false;
+                return;
+            }
+        }
+        allocTraits::deallocate(alloc, p, n);
+    }
+
+    /**
+     * @brief Returns true if p is the inline buffer
+     */
+    bool isInline(const elmtype *p) const {
+        if constexpr (inlineCap > 0) {
+            return p == (const elmtype *)small.bytes;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Destroys the live elements and frees the storage
+     */
+    void release() {
+        if (info == nullptr) {
+            return;
+        }
+        if constexpr (!std::is_trivially_destructible_v<elmtype>) {
+            for (int i = 0; i < size; i++) {
+                std::destroy_at(info + wrap(start + i));
+            }
+        }
+        deallocate(info, cap);
+        info = nullptr;
+    }
+
+    /**
+     * @brief Copies the live elements of src into freshly allocated storage of the same capacity
+     * 
+     * @details The copied elements start at index 0. Trivially copyable elements are copied with memcpy in at most two segments.
+     *          If src is an rvalue its elements are moved instead, leaving them for src to destroy.
+     */
+    template <typename Src> void copyFrom(Src &&src) {
+        cap = src.cap;
+        size = src.size;
+        growthFactor = src.growthFactor;
+        shrinkThreshold = src.shrinkThreshold;
+        reserved = src.reserved;
+        start = 0;
+        finish = tail();
+        info = allocate(cap);
+        int first = std::min(size, cap - src.start);
+        if constexpr (std::is_trivially_copyable_v<elmtype>) {
+            std::memcpy((void *)info, (const void *)(src.info + src.start), first * sizeof(elmtype));
+            std::memcpy((void *)(info + first), (const void *)src.info, (size - first) * sizeof(elmtype));
+        } else if constexpr (std::is_rvalue_reference_v<Src &&>) {
+            std::uninitialized_move_n(src.info + src.start, first, info);
+            std::uninitialized_move_n(src.info, size - first, info + first);
+        } else {
+            std::uninitialized_copy_n(src.info + src.start, first, info);
+            std::uninitialized_copy_n(src.info, size - first, info + first);
+        }
+    }
+
+    /**
+     * @brief Moves the live elements into new storage of capacity newCap and frees the old storage
+     * 
+     * @details The moved elements start at index 0. Trivially copyable elements are moved with memcpy in at most two segments.
+     *          Time complexity: O(size)
+     * 
+     * @param newCap The new capacity, must be at least size
+     */
+    void relocate(int newCap) {
+        if constexpr (inlineCap > 0) {
+            if (isInline(info) && newCap <= inlineCap) {
+                relocateInline(newCap);
+                return;
+            }
+        }
+        elmtype *newArr = allocate(newCap);
+        int first = std::min(size, cap - start);
+        if constexpr (std::is_trivially_copyable_v<elmtype>) {
+            std::memcpy((void *)newArr, (const void *)(info + start), first * sizeof(elmtype));
+            std::memcpy((void *)(newArr + first), (const void *)info, (size - first) * sizeof(elmtype));
+        } else {
+            std::uninitialized_move_n(info + start, first, newArr);
+            std::uninitialized_move_n(info, size - first, newArr + first);
+            std::destroy_n(info + start, first);
+            std::destroy_n(info, size - first);
+        }
+        deallocate(info, cap);
+        info = newArr;
+        cap = newCap;
+        start = 0;
+        finish = tail();
+    }
+
+    /**
+     * @brief Used by relocate to move the elements to the front of the inline buffer while it stays in use
+     * 
+     * @details The elements take a detour through a buffer on the stack, so the array never spills to the heap while it fits inline.
+     *          Time complexity: O(size)
+     */
+    void relocateInline(int newCap) {
+        alignas(elmtype) unsigned char tmpBytes[(inlineCap > 0 ? inlineCap : 1) * sizeof(elmtype)];
+        elmtype *tmp = (elmtype *)tmpBytes;
+        int first = std::min(size, cap - start);
+        if constexpr (std::is_trivially_copyable_v<elmtype>) {
+            std::memcpy((void *)tmp, (const void *)(info + start), first * sizeof(elmtype));
+            std::memcpy((void *)(tmp + first), (const void *)info, (size - first) * sizeof(elmtype));
+            std::memcpy((void *)info, (const void *)tmp, size * sizeof(elmtype));
+        } else {
+            std::uninitialized_move_n(info + start, first, tmp);
+            std::uninitialized_move_n(info, size - first, tmp + first);
+            std::destroy_n(info + start, first);
+            std::destroy_n(info, size - first);
+            std::uninitialized_move_n(tmp, size, info);
+            std::destroy_n(tmp, size);
+        }
+        cap = newCap;
+        start = 0;
+        finish = tail();
+    }
+
+    /**
+     * @brief Grows the capacity once, by repeated doubling, until it holds n elements
+     * 
+     * @details Time complexity: O(size) if the array is resized, O(1) otherwise
+     * 
+     * @param n The number of elements the array must hold
+     */
+    void growFor(int n) {
+        if (n <= cap) {
+            return;
+        }
+        int newCap = cap;
+        while (newCap < n) {
+            newCap = grownCapacity(newCap);
+        }
+        relocate(capPolicy::fit(newCap));
+    }
+
+    /**
+     * @brief Returns the capacity after one growth step from c, by the growth factor and at least by one element
+     */
+    int grownCapacity(int c) const {
+        double next = std::max(c * growthFactor, c + 1.0);
+        return next >= std::numeric_limits<int>::max() ? std::numeric_limits<int>::max() : (int)next;
+    }
+
+    /**
+     * @brief Copy constructs n elements of [first, last) into uninitialized storage starting at physical index pos
+     * 
+     * @details The elements are written in at most two contiguous segments: [pos, cap) and [0, rest). The storage must hold n more elements.
+     */
+    template <typename ForwardIt> void copySegments(ForwardIt first, ForwardIt last, int n, int pos) {
+        int head = std::min(n, cap - pos);
+        if constexpr (std::contiguous_iterator<ForwardIt> && std::is_trivially_copyable_v<elmtype> &&
+                      std::is_same_v<std::remove_cv_t<std::iter_value_t<ForwardIt>>, elmtype>) {
+            const elmtype *src = std::to_address(first);
+            std::memcpy((void *)(info + pos), (const void *)src, head * sizeof(elmtype));
+            std::memcpy((void *)info, (const void *)(src + head), (n - head) * sizeof(elmtype));
+        } else {
+            ForwardIt mid = std::next(first, head);
+            std::uninitialized_copy(first, mid, info + pos);
+            std::uninitialized_copy(mid, last, info);
+        }
+    }
+
+    /**
+     * @brief Used in the delFront and delEnd functions to shrink the capacity once size falls below the shrink threshold
+     * 
+     * @details Divides the capacity by the growth factor until the size is back above the threshold, then resizes once. Never goes below
+     *          the default capacity or the reserved capacity. Time complexity: O(1) (Amortized)
+     */
+    void checkCapDecrease() {
+        double fraction = std::min(shrinkThreshold, 0.5 / growthFactor);
+        if (size >= cap * fraction || cap <= std::max(reserved, defaultCap)) {
+            return;
+        }
+        int newCap = cap;
+        while (newCap > defaultCap && size < newCap * fraction) {
+            newCap = (int)(newCap / growthFactor);
+        }
+        newCap = capPolicy::fit(std::max({newCap, reserved, size, defaultCap}));
+        if (newCap < cap) {
+            relocate(newCap);
+        }
+    };
+
+    /**
+     * @brief Used in addFront and addEnd functions to grow the capacity of the array by the growth factor if size == cap
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     */
+    void checkCapIncrease() {
+        if (size == cap) {
+            relocate(capPolicy::fit(std::max(grownCapacity(cap), defaultCap)));
+        }
+        return;
+    };
+
+    /**
+     * @brief The unsigned integer type with the width of elmtype, used by radixSort for the digit keys
+     */
+    using radixKeyType = std::conditional_t<sizeof(elmtype) == 1, std::uint8_t,
+                         std::conditional_t<sizeof(elmtype) == 2, std::uint16_t,
+                         std::conditional_t<sizeof(elmtype) == 4, std::uint32_t, std::uint64_t>>>;
+
+    /**
+     * @brief Used by radixSort to map an element to an unsigned key with the same order
+     */
+    static radixKeyType radixKey(elmtype v) {
+        constexpr radixKeyType signBit = (radixKeyType)((radixKeyType)1 << (sizeof(elmtype) * 8 - 1));
+        radixKeyType key;
+        std::memcpy(&key, &v, sizeof(elmtype));
+        if constexpr (std::is_floating_point_v<elmtype>) {
+            return (key & signBit) ? (radixKeyType)~key : (radixKeyType)(key | signBit);
+        } else if constexpr (std::is_signed_v<elmtype>) {
+            return (radixKeyType)(key ^ signBit);
+        } else {
+            return key;
+        }
+    }
+
+    /**
+     * @brief Runs up to this length are sorted with insertion sort by stableSort
+     */
+    static constexpr int insertionCutoff = 32;
+
+    /**
+     * @brief Subarrays shorter than this are never handed to another thread by stableSort
+     */
+    static constexpr int parallelCutoff = 1 << 14;
+
+    /**
+     * @brief Makes the live elements contiguous and returns a pointer to the first one
+     * 
+     * @details Time complexity: O(size) if the array wraps around the end of the storage, O(1) otherwise
+     */
+    elmtype *linearize() {
+        if (start + size > cap) {
+            relocate(cap);
+        }
+        return info + start;
+    }
+
+    /**
+     * @brief Used by stableSort function to sort short runs with a stable insertion sort
+     * 
+     * @details Time complexity: O(n^2)
+     * 
+     * @param arr The run to sort
+     * @param n The length of the run
+     */
+    void insertionSort(elmtype *arr, int n) {
+        for (int i = 1; i < n; i++) {
+            if (!(arr[i] < arr[i - 1])) {
+                continue;
+            }
+            elmtype temp = std::move(arr[i]);
+            int j = i;
+            for (; j > 0 && temp < arr[j - 1]; j--) {
+                arr[j] = std::move(arr[j - 1]);
+            }
+            arr[j] = std::move(temp);
+        }
+    }
+
+    /**
+     * @brief Used by stableSort function to merge the sorted halves [0, m) and [m, n) of arr
+     * 
+     * @details The left half is moved into the scratch buffer and merged back with the right half in place. Time complexity: O(n)
+     * 
+     * @param arr The subarray to merge
+     * @param m The length of the left half (used to split the array)
+     * @param n The length of the subarray
+     * @param buf Uninitialized scratch storage for at least m elements
+     */
+    void merge(elmtype *arr, int m, int n, elmtype *buf) {
+        // The halves are already in order
+        if (!(arr[m] < arr[m - 1])) {
+            return;
+        }
+
+        if constexpr (std::is_trivially_copyable_v<elmtype>) {
+            std::memcpy((void *)buf, (const void *)arr, m * sizeof(elmtype));
+        } else {
+            std::uninitialized_move_n(arr, m, buf);
+        }
+
+        int indexL = 0, indexR = m, indexM = 0;
+
+        // Primary Merge Loop, ties keep the left element first
+        while (indexL < m && indexR < n) {
+            if (arr[indexR] < buf[indexL]) {
+                arr[indexM++] = std::move(arr[indexR++]);
+            } else {
+                arr[indexM++] = std::move(buf[indexL++]);
+            }
+        }
+
+        // Merge Remaining Lefts, remaining rights are already in place
+        while (indexL < m) {
+            arr[indexM++] = std::move(buf[indexL++]);
+        }
+
+        std::destroy_n(buf, m);
+    };
+
+    /**
+     * @brief Used by stableSort function to perform a mergesort on a contiguous subarray
+     * 
+     * @details While depth > 0 the left half is sorted on a new thread. The two halves use disjoint parts of the scratch buffer.
+     *          Time complexity: O(nlg(n))
+     * 
+     * @param arr The subarray to sort
+     * @param n The length of the subarray
+     * @param buf Uninitialized scratch storage for at least n / 2 elements
+     * @param depth The number of merge tree levels that may still fork a thread
+     */
+    void mergeSort(elmtype *arr, int n, elmtype *buf, int depth) {
+        if (n <= insertionCutoff) {
+            insertionSort(arr, n);
+            return;
+        }
+
+        int m = n / 2;
+        if (depth > 0 && n >= parallelCutoff) {
+            std::thread left([=, this] { mergeSort(arr, m, buf, depth - 1); });
+            mergeSort(arr + m, n - m, buf + m / 2, depth - 1);
+            left.join();
+        } else {
+            mergeSort(arr, m, buf, 0);
+            mergeSort(arr + m, n - m, buf + m / 2, 0);
+        }
+        merge(arr, m, n, buf);
+    };
+
+    /**
+     * @brief Used by QuickSelect and WCSelect to search for the Kth smallest element
+     * 
+     * @details Time complexity: O(n)
+     * 
+     * @param k The index of the element to find
+     * @param type The type of search to perform
+     * @param inPlace Whether to partition the array itself instead of a copy
+     * 
+     * @return The Kth smallest element of the array
+     */
+    elmtype select(int k, searchType type, bool inPlace) {
+        if (inPlace) {
+            elmtype *arr = linearize();
+            introSelect(arr, 0, size - 1, k - 1, type);
+            return arr[k - 1];
+        }
+
+        elmtype *arr = linearCopy();
+        introSelect(arr, 0, size - 1, k - 1, type);
+        elmtype result = std::move(arr[k - 1]);
+        std::destroy_n(arr, size);
+        deallocate(arr, size);
+        return result;
+    }
+
+    /**
+     * @brief Copies the live elements into new contiguous storage of size elements. The caller destroys and deallocates the copy.
+     */
+    elmtype *linearCopy() {
+        elmtype *arr = allocate(size);
+        auto [head, tail] = segments();
+        if constexpr (std::is_trivially_copyable_v<elmtype>) {
+            std::memcpy((void *)arr, (const void *)head.data(), head.size() * sizeof(elmtype));
+            std::memcpy((void *)(arr + head.size()), (const void *)tail.data(), tail.size() * sizeof(elmtype));
+        } else {
+            std::uninitialized_copy(head.begin(), head.end(), arr);
+            std::uninitialized_copy(tail.begin(), tail.end(), arr + head.size());
+        }
+        return arr;
+    }
+
+    /**
+     * @brief Rearranges arr[l..r] so that arr[k] holds the element that belongs there in sorted order
+     * 
+     * @details Elements before k are not greater and elements after k are not smaller than arr[k]. standard picks median of three pivots and
+     *          switches to median of medians pivots once its 2 * lg(n) round budget is spent; worstCase always uses median of medians.
+     *          Ranges of up to insertionCutoff elements are finished with insertion sort. Time complexity: O(n), n = r - l + 1
+     * 
+     * @param arr The array to search
+     * @param l The left index of the subarray
+     * @param r The right index of the subarray
+     * @param k The zero-based index of the element to find, l <= k <= r
+     * @param type The type of search to perform
+     */
+    void introSelect(elmtype *arr, int l, int r, int k, searchType type) {
+        int budget = 0;
+        for (int n = r - l + 1; n > 1; n >>= 1) {
+            budget += 2;
+        }
+
+        while (r - l + 1 > insertionCutoff) {
+            int pivotIndex = (type == worstCase || budget <= 0) ? medianOfMedians(arr, l, r) : medianOfThree(arr, l, r);
+            budget--;
+
+            elmtype pivot = arr[pivotIndex];
+            int lt, gt;
+            partition(arr, l, r, pivot, lt, gt);
+
+            if (k < lt) {
+                r = lt - 1;
+            } else if (k > gt) {
+                l = gt + 1;
+            } else {
+                return;
+            }
+        }
+        insertionSort(arr + l, r - l + 1);
+    }
+
+    /**
+     * @brief Used by selectMany to place every target index of arr[l..r] in its sorted position
+     * 
+     * @details Partitions around one pivot, then recurses into each side with the targets that fall on it. Targets inside the run of
+     *          elements equal to the pivot are already in place. Time complexity: O(n * lg(m)), n = r - l + 1, m = number of targets
+     * 
+     * @param arr The array to search
+     * @param l The left index of the subarray
+     * @param r The right index of the subarray
+     * @param targets The sorted, zero-based target indices
+     * @param tl The first target in arr[l..r]
+     * @param tr The last target in arr[l..r]
+     * @param budget The median of three rounds left before falling back to median of medians pivots
+     */
+    void multiSelect(elmtype *arr, int l, int r, int *targets, int tl, int tr, int budget) {
+        if (tl > tr) {
+            return;
+        }
+        if (tl == tr) {
+            introSelect(arr, l, r, targets[tl], budget > 0 ? standard : worstCase);
+            return;
+        }
+        if (r - l + 1 <= insertionCutoff) {
+            insertionSort(arr + l, r - l + 1);
+            return;
+        }
+
+        elmtype pivot = arr[budget > 0 ? medianOfThree(arr, l, r) : medianOfMedians(arr, l, r)];
+        int lt, gt;
+        partition(arr, l, r, pivot, lt, gt);
+
+        int lowEnd = tl, highStart = tr;
+        while (lowEnd <= tr && targets[lowEnd] < lt) {
+            lowEnd++;
+        }
+        while (highStart >= tl && targets[highStart] > gt) {
+            highStart--;
+        }
+        multiSelect(arr, l, lt - 1, targets, tl, lowEnd - 1, budget - 1);
+        multiSelect(arr, gt + 1, r, targets, highStart + 1, tr, budget - 1);
+    }
+
+    /**
+     * @brief Used by topK and partialSort to sort arr[0..k) with the stableSort mergesort
+     * 
+     * @details Time complexity: O(k * lg(k))
+     */
+    void sortPrefix(elmtype *arr, int k) {
+        elmtype *buf = allocate(k / 2);
+        mergeSort(arr, k, buf, 0);
+        deallocate(buf, k / 2);
+    }
+
+    /**
+     * @brief Returns the index of the median of arr[l], arr[(l + r) / 2] and arr[r]
+     * 
+     * @details Time complexity: O(1)
+     */
+    int medianOfThree(elmtype *arr, int l, int r) {
+        int m = l + (r - l) / 2;
+        if (arr[m] < arr[l]) {
+            std::swap(l, m);
+        }
+        if (arr[r] < arr[m]) {
+            m = (arr[r] < arr[l]) ? l : r;
+        }
+        return m;
+    }
+
+    /**
+     * @brief Returns the index of the median of medians (subarray size = 5) of arr[l..r]
+     * 
+     * @details Each group of 5 is sorted with insertion sort and its median is swapped to the front of the range, then the median of those
+     *          medians is found with a worst case select. Time complexity: O(n), n = r - l + 1
+     */
+    int medianOfMedians(elmtype *arr, int l, int r) {
+        int groups = 0;
+        for (int i = l; i <= r; i += 5) {
+            int len = std::min(5, r - i + 1);
+            insertionSort(arr + i, len);
+            swap(&arr[l + groups], &arr[i + len / 2]);
+            groups++;
+        }
+        int mid = l + (groups - 1) / 2;
+        introSelect(arr, l, l + groups - 1, mid, worstCase);
+        return mid;
+    }
+
+    /**
+     * @brief Three-way partitions arr[l..r] around pivot
+     * 
+     * @details Afterwards arr[l..lt) < pivot, arr[lt..gt] are equal to pivot and arr(gt..r] > pivot, which keeps runs of duplicates from
+     *          degrading the search. Time complexity: O(r - l)
+     * 
+     * @param arr The array to partition
+     * @param l The left index of the subarray
+     * @param r The right index of the subarray
+     * @param pivot The pivot element, must not refer into arr
+     * @param lt Receives the index of the first element equal to pivot
+     * @param gt Receives the index of the last element equal to pivot
+     */
+    void partition(elmtype *arr, int l, int r, const elmtype &pivot, int &lt, int &gt) {
+        lt = l;
+        gt = r;
+        for (int i = l; i <= gt;) {
+            if (arr[i] < pivot) {
+                swap(&arr[lt++], &arr[i++]);
+            } else if (pivot < arr[i]) {
+                swap(&arr[i], &arr[gt--]);
+            } else {
+                i++;
+            }
+        }
+    }
+};
+
+/**
+ * @brief A circular dynamic array with room for inlineCap elements inside the object
+ * 
+ * @details Construction, clear() and small arrays never touch the heap; the array spills to the allocator only when it outgrows the
+ *          inline buffer and moves back when it shrinks enough. Moving an array that is stored inline moves its elements one by one.
+ * 
+ * @tparam elmtype The type of element stored in the array
+ * @tparam inlineCap The number of elements stored inline
+ * @tparam capPolicy The capacity policy, either ModuloCapacity (default) or PowerOfTwoCapacity
+ */
+template <typename elmtype, int inlineCap, typename capPolicy = ModuloCapacity>
+using SmallCircularDynamicArray = CircularDynamicArray<elmtype, capPolicy, std::allocator<elmtype>, inlineCap>;
+
+/**
+ * @brief Implements a circular dynamic array with O(1) copy-on-write snapshots
+ * 
+ * @details The elements live in fixed-size chunks of 2^chunkBits elements. A circular dynamic array of reference counted chunk pointers
+ *          (the table) orders the chunks, and the table is reference counted as well. Copying the array, or calling snapshot(), only
+ *          shares the table. The first write after that copies the table (one pointer per chunk) and each write copies the chunk it
+ *          lands in if another copy still uses it, so a writer only pays for the chunks it touches. Reads never copy.
+ * 
+ * @note Snapshots must be taken on the thread that owns the array (or under its lock); a snapshot can then be read on any thread
+ *       while the original keeps changing.
+ * 
+ * @tparam elmtype The type of element stored in the array, must be default constructible
+ * @tparam chunkBits The base 2 logarithm of the number of elements per chunk
+ */
+template <typename elmtype, int chunkBits = 10> class CowCircularDynamicArray {
+
+    static_assert(chunkBits > 0 && chunkBits < 24, "chunkBits must be between 1 and 23");
+
+    public:
+
+    /**
+     * @brief Default Constructor
+     * 
+     * @details Initializes an empty array without any chunks
+     */
+    CowCircularDynamicArray() : table(Ref<Table>::make()) {}
+
+    /**
+     * @brief Returns a snapshot of the array that shares all of its storage
+     * 
+     * @details Same as the copy constructor. Time complexity: O(1)
+     */
+    CowCircularDynamicArray snapshot() const { return *this; }
+
+    /**
+     * @brief Returns the size of the array
+     */
+    int length() const { return size; }
+
+    /**
+     * @brief Returns true if some storage is shared with another copy
+     * 
+     * @details Time complexity: O(1)
+     */
+    bool isShared() const { return !table.unique(); }
+
+    /**
+     * @brief Returns a constant reference to the element at index i, or to the burner element if the index is invalid
+     * 
+     * @details Never copies. Time complexity: O(1)
+     */
+    const elmtype &at(int i) const {
+        if (i < 0 || i >= size) {
+            return burner;
+        }
+        int p = head + i;
+        return (*table)[p >> chunkBits]->items[p & chunkMask];
+    }
+
+    /**
+     * @brief Bracket operator. Returns burner element if index is invalid.
+     * 
+     * @details The reference is writable, so the chunk holding the element is copied first if it is shared.
+     *          Time complexity: O(1), plus O(number of chunks + chunk size) for the first write to shared storage
+     */
+    elmtype &operator[](int i) {
+        if (i < 0 || i >= size) {
+            return burner;
+        }
+        int p = head + i;
+        return ownChunk(p >> chunkBits).items[p & chunkMask];
+    }
+
+    /**
+     * @brief Adds an element to the front of the array
+     * 
+     * @details Time complexity: O(1) (Amortized), plus the copy of shared storage
+     */
+    void addFront(const elmtype &v) {
+        if (head == 0) {
+            ownTable().addFront(Ref<Chunk>::make());
+            head = chunkSize;
+        }
+        ownChunk((head - 1) >> chunkBits).items[(head - 1) & chunkMask] = v;
+        head--;
+        size++;
+    }
+
+    /**
+     * @brief Adds an element to the end of the array
+     * 
+     * @details Time complexity: O(1) (Amortized), plus the copy of shared storage
+     */
+    void addEnd(const elmtype &v) {
+        int p = head + size;
+        if (p == table->length() * chunkSize) {
+            ownTable().addEnd(Ref<Chunk>::make());
+        }
+        ownChunk(p >> chunkBits).items[p & chunkMask] = v;
+        size++;
+    }
+
+    /**
+     * @brief Removes the element at the front of the array
+     * 
+     * @details The element itself is released when its chunk is no longer used. Does nothing if the array is empty.
+     *          Time complexity: O(1) (Amortized)
+     */
+    void delFront() {
+        if (size == 0) {
+            return;
+        }
+        head++;
+        size--;
+        if (head == chunkSize) {
+            ownTable().delFront();
+            head = 0;
+        }
+    }
+
+    /**
+     * @brief Removes the element at the end of the array
+     * 
+     * @details The element itself is released when its chunk is no longer used. Does nothing if the array is empty.
+     *          Time complexity: O(1) (Amortized)
+     */
+    void delEnd() {
+        if (size == 0) {
+            return;
+        }
+        size--;
+        if (((head + size) & chunkMask) == 0 && table->length() > (head + size) / chunkSize) {
+            ownTable().delEnd();
+        }
+    }
+
+    /**
+     * @brief Removes all elements. Snapshots keep their contents.
+     */
+    void clear() {
+        table = Ref<Table>::make();
+        head = 0;
+        size = 0;
+    }
+
+    /**
+     * @brief Calls f with a constant reference to each element, in order
+     * 
+     * @details Walks each chunk as a contiguous block. Never copies. Time complexity: O(size)
+     */
+    template <typename F> void forEach(F f) const {
+        for (int p = head; p < head + size;) {
+            const Chunk &c = *(*table)[p >> chunkBits];
+            int last = std::min((p | chunkMask) + 1, head + size);
+            for (; p < last; p++) {
+                f(c.items[p & chunkMask]);
+            }
+        }
+    }
+
+    private:
+
+    /**
+     * @brief The number of elements per chunk and the mask for the index within a chunk
+     */
+    static constexpr int chunkSize = 1 << chunkBits;
+    static constexpr int chunkMask = chunkSize - 1;
+
+    /**
+     * @brief A reference counted pointer whose uniqueness check is an acquire load
+     * 
+     * @details std::shared_ptr::use_count is a relaxed load, so seeing a count of 1 does not order an in-place write after the reads
+     *          another thread made through a copy it has since released. Here releasing a copy decrements with release ordering and
+     *          unique() loads with acquire ordering, so those reads happen before the write.
+     */
+    template <typename T> class Ref {
+
+        public:
+
+        Ref() = default;
+
+        Ref(const Ref &src) : node(src.node) {
+            if (node != nullptr) {
+                node->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        Ref(Ref &&src) noexcept : node(std::exchange(src.node, nullptr)) {}
+
+        Ref &operator=(Ref src) noexcept {
+            std::swap(node, src.node);
+            return *this;
+        }
+
+        ~Ref() {
+            if (node != nullptr && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete node;
+            }
+        }
+
+        /**
+         * @brief Returns a pointer to a new T constructed from args
+         */
+        template <typename... Args> static Ref make(Args &&...args) {
+            Ref r;
+            r.node = new Node{{1}, T(std::forward<Args>(args)...)};
+            return r;
+        }
+
+        /**
+         * @brief Returns true if no other Ref points to the same T
+         */
+        bool unique() const { return node == nullptr || node->refs.load(std::memory_order_acquire) == 1; }
+
+        T &operator*() const { return node->value; }
+
+        T *operator->() const { return &node->value; }
+
+        private:
+
+        struct Node {
+            std::atomic<int> refs;
+            T value;
+        };
+
+        Node *node = nullptr;
+    };
+
+    /**
+     * @brief A fixed-size block of elements
+     */
+    struct Chunk {
+        elmtype items[chunkSize] = {};
+    };
+
+    using Table = CircularDynamicArray<Ref<Chunk>>;
+
+    /**
+     * @brief The chunks in order, shared between copies until one of them writes
+     */
+    Ref<Table> table;
+
+    /**
+     * @brief The position of the first element within the first chunk
+     */
+    int head = 0;
+
+    /**
+     * @brief The size of the array
+     */
+    int size = 0;
+
+    /**
+     * @brief Burner element for error handling
+     */
+    elmtype burner = elmtype();
+
+    /**
+     * @brief Returns the table, copying it first if another copy shares it
+     */
+    Table &ownTable() {
+        if (!table.unique()) {
+            table = Ref<Table>::make(*table);
+        }
+        return *table;
+    }
+
+    /**
+     * @brief Returns chunk k, copying it (and the table) first if another copy shares it
+     */
+    Chunk &ownChunk(int k) {
+        Ref<Chunk> &c = ownTable()[k];
+        if (!c.unique()) {
+            c = Ref<Chunk>::make(*c);
+        }
+        return *c;
+    }
+};
+
+#if DATASTRUCTS_POSIX_MMAP
+/**
+ * @brief Implements a circular dynamic array whose storage is a memory-mapped file
+ * 
+ * @details The file starts with a small header holding the capacity, size, start and finish of the ring, followed by the element
+ *          storage, so the array is saved as a side effect of every operation and reopening an existing file is O(1) regardless of its
+ *          size. The capacity is a power of two. Growing extends the file with ftruncate and remaps it; if the ring wraps, only the
+ *          segment after the wrap point is moved. The capacity never shrinks, so a checkpoint file keeps its high-water size.
+ *          Changes reach the file through the page cache; call sync() to wait until they are on disk. Failures to open, validate,
+ *          extend or map the file throw std::system_error.
+ * 
+ * @note The file layout uses the host byte order and the element layout of the compiler, so files are not portable between platforms.
+ * 
+ * @tparam elmtype The type of element stored in the array, must be trivially copyable
+ */
+template <typename elmtype> class MappedCircularDynamicArray {
+
+    static_assert(std::is_trivially_copyable_v<elmtype>, "MappedCircularDynamicArray requires a trivially copyable element type");
+    static_assert(alignof(elmtype) <= 64, "MappedCircularDynamicArray supports alignments up to 64 bytes");
+
+    public:
+
+    /**
+     * @brief Opens the array stored in path, creating the file if it does not exist or is empty
+     * 
+     * @details An existing file is validated against the element size and mapped as is. Time complexity: O(1)
+     * 
+     * @param path The file that holds the array
+     * @param capacity The initial capacity of a new file, rounded up to a power of two with a minimum of 2
+     */
+    MappedCircularDynamicArray(const std::string &path, int capacity = 2) {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            fail("fstat " + path);
+        }
+
+        if (st.st_size == 0) {
+            int newCap = PowerOfTwoCapacity::fit(std::max(capacity, 2));
+            if (::ftruncate(fd, (off_t)bytesFor(newCap)) != 0) {
+                fail("ftruncate " + path);
+            }
+            map(bytesFor(newCap));
+            header->magic = fileMagic;
+            header->elementSize = sizeof(elmtype);
+            header->cap = newCap;
+            header->size = 0;
+            header->start = 0;
+            header->finish = -1;
+            return;
+        }
+
+        if ((std::size_t)st.st_size < headerSize) {
+            fail("truncated header in " + path, EINVAL);
+        }
+        map((std::size_t)st.st_size);
+        // cap is checked against the int range before bytesFor, which could otherwise wrap for a corrupt header
+        constexpr std::int64_t maxCap = (std::numeric_limits<int>::max)();
+        if (header->magic != fileMagic || header->elementSize != sizeof(elmtype) || header->cap > maxCap || header->cap < 2 ||
+            !std::has_single_bit((std::uint64_t)header->cap) || bytesFor(header->cap) > mappedBytes ||
+            header->size < 0 || header->size > header->cap || header->start < 0 || header->start >= header->cap) {
+            fail("not a matching array file: " + path, EINVAL);
+        }
+    }
+
+    MappedCircularDynamicArray(const MappedCircularDynamicArray &) = delete;
+    MappedCircularDynamicArray &operator=(const MappedCircularDynamicArray &) = delete;
+
+    /**
+     * @brief Destructor. Unmaps and closes the file; the contents stay in the file.
+     */
+    ~MappedCircularDynamicArray() {
+        ::munmap(base, mappedBytes);
+        ::close(fd);
+    }
+
+    /**
+     * @brief Returns the size of the array
+     */
+    int length() const { return (int)header->size; }
+
+    /**
+     * @brief Returns the capacity of the array
+     */
+    int capacity() const { return (int)header->cap; }
+
+    /**
+     * @brief Bracket operator. Returns burner element if index is invalid.
+     */
+    elmtype &operator[](int i) {
+        if (i < 0 || i >= header->size) {
+            return burner;
+        }
+        return info[wrap(header->start + i)];
+    }
+
+    /**
+     * @brief Adds an element to the front of the array
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     */
+    void addFront(const elmtype &v) {
+        if (header->size == header->cap) {
+            // v may refer to an element of this array
+            elmtype copy = v;
+            grow(header->cap * 2);
+            addFront(copy);
+            return;
+        }
+        std::int64_t pos = wrap(header->start - 1);
+        std::memcpy((void *)(info + pos), (const void *)&v, sizeof(elmtype));
+        header->start = pos;
+        header->finish = wrap(pos + header->size);
+        header->size++;
+    }
+
+    /**
+     * @brief Adds an element to the end of the array
+     * 
+     * @details Time complexity: O(1) (Amortized)
+     */
+    void addEnd(const elmtype &v) {
+        if (header->size == header->cap) {
+            elmtype copy = v;
+            grow(header->cap * 2);
+            addEnd(copy);
+            return;
+        }
+        std::int64_t pos = wrap(header->start + header->size);
+        std::memcpy((void *)(info + pos), (const void *)&v, sizeof(elmtype));
+        header->finish = pos;
+        header->size++;
+    }
+
+    /**
+     * @brief Adds the elements of a span to the end of the array, keeping their order
+     * 
+     * @details Grows the file at most once and copies the elements in at most two segments. The span must not refer to elements of this
+     *          array. Time complexity: O(n), n = s.size()
+     */
+    void appendRange(std::span<const elmtype> s) {
+        std::int64_t n = (std::int64_t)s.size();
+        if (n == 0) {
+            return;
+        }
+        if (header->size + n > header->cap) {
+            grow((std::int64_t)std::bit_ceil((std::uint64_t)(header->size + n)));
+        }
+        std::int64_t pos = wrap(header->start + header->size);
+        std::int64_t first = std::min(n, header->cap - pos);
+        std::memcpy((void *)(info + pos), (const void *)s.data(), first * sizeof(elmtype));
+        std::memcpy((void *)info, (const void *)(s.data() + first), (n - first) * sizeof(elmtype));
+        header->size += n;
+        header->finish = wrap(header->start + header->size - 1);
+    }
+
+    /**
+     * @brief Removes the element at the front of the array
+     * 
+     * @details Does nothing if the array is empty. Time complexity: O(1)
+     */
+    void delFront() {
+        if (header->size == 0) {
+            return;
+        }
+        header->start = wrap(header->start + 1);
+        header->size--;
+    }
+
+    /**
+     * @brief Removes the element at the end of the array
+     * 
+     * @details Does nothing if the array is empty. Time complexity: O(1)
+     */
+    void delEnd() {
+        if (header->size == 0) {
+            return;
+        }
+        header->finish = wrap(header->finish - 1);
+        header->size--;
+    }
+
+    /**
+     * @brief Removes all elements. The capacity and the file size are kept.
+     */
+    void clear() {
+        header->size = 0;
+        header->start = 0;
+        header->finish = -1;
+    }
+
+    /**
+     * @brief Returns the live elements as at most two contiguous spans, in order
+     * 
+     * @details Time complexity: O(1)
+     */
+    std::pair<std::span<elmtype>, std::span<elmtype>> segments() {
+        std::size_t first = (std::size_t)std::min(header->size, header->cap - header->start);
+        return {std::span<elmtype>(info + header->start, first), std::span<elmtype>(info, (std::size_t)header->size - first)};
+    }
+
+    /**
+     * @brief Writes the mapped pages back to the file and waits for the write to finish
+     * 
+     * @details Time complexity: O(number of dirty pages)
+     */
+    void sync() {
+        if (::msync(base, mappedBytes, MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+    }
+
+    private:
+
+    /**
+     * @brief The layout of the start of the file
+     */
+    struct Header {
+        std::uint64_t magic;
+        std::uint64_t elementSize;
+        std::int64_t cap;
+        std::int64_t size;
+        std::int64_t start;
+        std::int64_t finish;
+    };
+
+    /**
+     * @brief Identifies files written by this class ("CDAMAP01")
+     */
+    static constexpr std::uint64_t fileMagic = 0x3130504d41414443ull;
+
+    /**
+     * @brief The element storage starts at this offset, which keeps it aligned to a cache line
+     */
+    static constexpr std::size_t headerSize = 64;
+    static_assert(sizeof(Header) <= headerSize);
+
+    /**
+     * @brief The file descriptor of the open file
+     */
+    int fd = -1;
+
+    /**
+     * @brief The start and length of the mapping
+     */
+    char *base = nullptr;
+    std::size_t mappedBytes = 0;
+
+    /**
+     * @brief The header and the element storage inside the mapping
+     */
+    Header *header = nullptr;
+    elmtype *info = nullptr;
+
+    /**
+     * @brief Burner element for error handling
+     */
+    elmtype burner = elmtype();
+
+    /**
+     * @brief Wraps an index into the range [0, cap). Also valid for i = -1.
+     */
+    std::int64_t wrap(std::int64_t i) const { return i & (header->cap - 1); }
+
+    /**
+     * @brief Returns the file size needed for cap elements
+     */
+    static std::size_t bytesFor(std::int64_t cap) { return headerSize + (std::size_t)cap * sizeof(elmtype); }
+
+    /**
+     * @brief Releases the file and throws a std::system_error
+     */
+    [[noreturn]] void fail(const std::string &what, int error = 0) {
+        int code = error != 0 ? error : errno;
+        if (base != nullptr) {
+            ::munmap(base, mappedBytes);
+        }
+        ::close(fd);
+        throw std::system_error(code, std::generic_category(), what);
+    }
+
+    /**
+     * @brief Maps the first bytes of the file
+     */
+    void map(std::size_t bytes) {
+        void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            fail("mmap");
+        }
+        setMapping(p, bytes);
+    }
+
+    /**
+     * @brief Points header and info into a new mapping
+     */
+    void setMapping(void *p, std::size_t bytes) {
+        base = (char *)p;
+        mappedBytes = bytes;
+        header = (Header *)base;
+        info = (elmtype *)(base + headerSize);
+    }
+
+    /**
+     * @brief Extends the file to newCap elements and remaps it
+     * 
+     * @details If the ring wraps, the segment from start to the old end of the storage is moved to the new end, so the elements stay in
+     *          ring order without copying the rest. Time complexity: O(cap - start) plus the cost of remapping
+     */
+    void grow(std::int64_t newCap) {
+        if (newCap > (std::numeric_limits<int>::max)()) {
+            throw std::length_error("MappedCircularDynamicArray: capacity above the int range");
+        }
+        std::int64_t oldCap = header->cap;
+        std::size_t bytes = bytesFor(newCap);
+        if (::ftruncate(fd, (off_t)bytes) != 0) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate");
+        }
+#if defined(__linux__)
+        void *p = ::mremap(base, mappedBytes, bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mremap");
+        }
+#else
+        void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        ::munmap(base, mappedBytes);
+#endif
+        setMapping(p, bytes);
+
+        if (header->start + header->size > oldCap) {
+            std::int64_t headLen = oldCap - header->start;
+            std::memmove((void *)(info + newCap - headLen), (const void *)(info + header->start), headLen * sizeof(elmtype));
+            header->start = newCap - headLen;
+        }
+        header->cap = newCap;
+        header->finish = header->size == 0 ? -1 : (header->start + header->size - 1) & (newCap - 1);
+    }
+};
+#endif
+
+/**
+ * @brief Implements a read-only search index over a sorted sequence using the Eytzinger (breadth-first) layout
+ * 
+ * @details The elements are copied into a 1-based array where node k has children 2k and 2k+1, so the first levels of every search share
+ *          the same few cache lines and the next levels are prefetched while the current comparison runs. Each node remembers the index
+ *          the element had in the source, so the results map back to positions in the circular dynamic array or span it was built from.
+ *          The index does not observe later changes to its source.
+ * 
+ * @tparam elmtype The type of element stored in the index
+ */
+template <typename elmtype> class EytzingerIndex {
+
+    public:
+
+    /**
+     * @brief Builds the index from a sorted span
+     * 
+     * @details Time complexity: O(n)
+     * 
+     * @param sorted The elements, sorted in non-decreasing order by operator<
+     */
+    EytzingerIndex(std::span<const elmtype> sorted) {
+        build(sorted);
+    }
+
+    /**
+     * @brief Builds the index from a sorted circular dynamic array
+     * 
+     * @details Time complexity: O(n)
+     * 
+     * @param sorted The array, sorted in non-decreasing order by operator<
+     */
+    template <typename capPolicy, typename Alloc, int inlineCap>
+    EytzingerIndex(const CircularDynamicArray<elmtype, capPolicy, Alloc, inlineCap> &sorted) {
+        auto [head, tail] = sorted.segments();
+        if (tail.empty()) {
+            build(head);
+            return;
+        }
+        // The two segments are stitched together in a temporary so the in-order fill can walk a single range
+        std::vector<elmtype> flat(head.begin(), head.end());
+        flat.insert(flat.end(), tail.begin(), tail.end());
+        build(std::span<const elmtype>(flat));
+    }
+
+    EytzingerIndex(const EytzingerIndex &) = delete;
+    EytzingerIndex &operator=(const EytzingerIndex &) = delete;
+
+    /**
+     * @brief Destructor
+     */
+    ~EytzingerIndex() {
+        for (int k = 1; k <= size; k++) {
+            std::destroy_at(tree + k);
+        }
+        ::operator delete(tree, std::align_val_t(cacheLineSize));
+        delete[] rank;
+    }
+
+    /**
+     * @brief Returns the number of elements in the index
+     */
+    int length() const { return size; }
+
+    /**
+     * @brief Finds the first element that is not less than e
+     * 
+     * @details See node(). Time complexity: O(lg(n))
+     * 
+     * @param e The element to search for
+     * 
+     * @return The source index of the first element not less than e, or length() if there is none
+     */
+    int lowerBound(const elmtype &e) const { return rank[node(e)]; }
+
+    /**
+     * @brief Performs a search for element e
+     * 
+     * @details Time complexity: O(lg(n))
+     * 
+     * @param e The element to search for
+     * 
+     * @return The source index of the first occurrence of the element if found, -1 otherwise
+     */
+    int find(const elmtype &e) const {
+        int k = node(e);
+        return k != 0 && !(e < tree[k]) ? rank[k] : -1;
+    }
+
+    /**
+     * @brief Returns true if the index contains element e
+     * 
+     * @details Time complexity: O(lg(n))
+     */
+    bool contains(const elmtype &e) const { return find(e) != -1; }
+
+    private:
+
+    /**
+     * @brief Elements per cache line, used as the prefetch distance in nodes
+     */
+    static constexpr std::size_t prefetchStride = std::max<std::size_t>(1, cacheLineSize / sizeof(elmtype));
+
+    /**
+     * @brief The number of elements in the index
+     */
+    int size = 0;
+
+    /**
+     * @brief The elements in breadth-first order, 1-based and aligned to a cache line
+     */
+    elmtype *tree = nullptr;
+
+    /**
+     * @brief The source index of the element at each node; rank[0] is size so a failed search maps to length()
+     */
+    int *rank = nullptr;
+
+    /**
+     * @brief Allocates the tree and fills it with an in-order walk
+     * 
+     * @details Time complexity: O(n)
+     */
+    void build(std::span<const elmtype> sorted) {
+        size = (int)sorted.size();
+        tree = (elmtype *)::operator new((size + 1) * sizeof(elmtype), std::align_val_t(cacheLineSize));
+        rank = new int[size + 1];
+        rank[0] = size;
+
+        // An in-order walk of the implicit tree visits the nodes in sorted order
+        int k = 1;
+        while (2 * k <= size) {
+            k = 2 * k;
+        }
+        for (int i = 0; i < size; i++) {
+            std::construct_at(tree + k, sorted[i]);
+            rank[k] = i;
+            if (2 * k + 1 <= size) {
+                // Leftmost node of the right subtree
+                k = 2 * k + 1;
+                while (2 * k <= size) {
+                    k = 2 * k;
+                }
+            } else {
+                // Climb past the right children, the next node is the parent of the last left child
+                k >>= std::countr_one((unsigned)k) + 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Used by lowerBound and find to return the node of the first element not less than e, or 0 if there is none
+     * 
+     * @details Descends the implicit tree without a data-dependent branch, prefetching the cache line that holds the descendants four
+     *          levels down (for 4-byte elements). The final node is recovered from the path by stripping the trailing right turns.
+     */
+    int node(const elmtype &e) const {
+        int k = 1;
+        while (k <= size) {
+            __builtin_prefetch(tree + (std::size_t)k * prefetchStride);
+            k = 2 * k + (tree[k] < e ? 1 : 0);
+        }
+        return k >> (std::countr_one((unsigned)k) + 1);
+    }
+};
+
+/**
+ * @brief Implements a fixed capacity, lock-free single-producer/single-consumer ring buffer
+ * 
+ * @details Uses the same start/finish ring layout as the circular dynamic array with a power-of-two capacity, but the indices are atomic
+ *          counters that only ever increase and are wrapped with a bitmask on access. The producer owns the tail counter and the consumer owns
+ *          the head counter; each side also keeps a cached copy of the other side's counter so the shared cache line is only read when the
+ *          ring looks full or empty. The counters live on separate cache lines to avoid false sharing.
+ * 
+ * @note Exactly one thread may call the addEnd functions and exactly one thread may call the delFront functions at any time.
+ * 
+ * @tparam elmtype The type of element stored in the ring buffer
+ */
+template <typename elmtype> class SPSCRingBuffer {
+
+    public:
+
+    /**
+     * @brief Constructs an empty ring buffer
+     * 
+     * @details The capacity is rounded up to a power of two, with a minimum of 2
+     * 
+     * @param capacity The number of elements the ring buffer can hold
+     */
+    SPSCRingBuffer(int capacity) {
+        cap = PowerOfTwoCapacity::fit(std::max(capacity, 2));
+        mask = cap - 1;
+        info = std::allocator<elmtype>().allocate(cap);
+    }
+
+    SPSCRingBuffer(const SPSCRingBuffer &) = delete;
+    SPSCRingBuffer &operator=(const SPSCRingBuffer &) = delete;
+
+    /**
+     * @brief Destructor
+     * 
+     * @details Destroys the elements left in the ring buffer and frees the storage. No other thread may be using the ring buffer.
+     */
+    ~SPSCRingBuffer() {
+        std::size_t t = tail.load(std::memory_order_acquire);
+        for (std::size_t h = head.load(std::memory_order_acquire); h != t; h++) {
+            std::destroy_at(info + (h & mask));
+        }
+        std::allocator<elmtype>().deallocate(info, cap);
+    }
+
+    /**
+     * @brief Returns the number of elements in the ring buffer
+     * 
+     * @details The value is exact when called from the producer or the consumer thread while the other side is idle, and a snapshot otherwise
+     */
+    int length() { return (int)(tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire)); }
+
+    /**
+     * @brief Returns the capacity of the ring buffer
+     */
+    int capacity() { return (int)cap; }
+
+    /**
+     * @brief Adds a copy of an element to the end of the ring buffer. Producer only.
+     * 
+     * @details Time complexity: O(1)
+     * 
+     * @return True if the element was added, false if the ring buffer is full
+     */
+    bool addEnd(const elmtype &v) { return emplaceEnd(v); }
+
+    /**
+     * @brief Moves an element to the end of the ring buffer. Producer only.
+     * 
+     * @details Time complexity: O(1)
+     * 
+     * @return True if the element was added, false if the ring buffer is full
+     */
+    bool addEnd(elmtype &&v) { return emplaceEnd(std::move(v)); }
+
+    /**
+     * @brief Constructs an element in place at the end of the ring buffer. Producer only.
+     * 
+     * @details Time complexity: O(1)
+     * 
+     * @return True if the element was added, false if the ring buffer is full
+     */
+    template <typename... Args> bool emplaceEnd(Args &&...args) {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead == cap) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == cap) {
+                return false;
+            }
+        }
+        ::new ((void *)(info + (t & mask))) elmtype(std::forward<Args>(args)...);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the element at the front of the ring buffer. Consumer only.
+     * 
+     * @details Time complexity: O(1)
+     * 
+     * @param out Receives the removed element
+     * 
+     * @return True if an element was removed, false if the ring buffer is empty
+     */
+    bool delFront(elmtype &out) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) {
+                return false;
+            }
+        }
+        elmtype *slot = info + (h & mask);
+        out = std::move(*slot);
+        std::destroy_at(slot);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Adds up to n elements to the end of the ring buffer with a single publish. Producer only.
+     * 
+     * @details The elements are copied in at most two contiguous segments; trivially copyable elements are copied with memcpy.
+     *          Does nothing if n <= 0. Time complexity: O(n)
+     * 
+     * @param src The elements to add
+     * @param n The number of elements to add
+     * 
+     * @return The number of elements added, which is less than n if the ring buffer fills up
+     */
+    int addEndBatch(const elmtype *src, int n) {
+        if (n <= 0) {
+            return 0;
+        }
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        std::size_t free = cap - (t - cachedHead);
+        if (free < (std::size_t)n) {
+            cachedHead = head.load(std::memory_order_acquire);
+            free = cap - (t - cachedHead);
+        }
+        int k = (int)std::min(free, (std::size_t)n);
+        int pos = (int)(t & mask);
+        int first = std::min(k, (int)cap - pos);
+        if constexpr (std::is_trivially_copyable_v<elmtype>) {
+            std::memcpy((void *)(info + pos), (const void *)src, first * sizeof(elmtype));
+            std::memcpy((void *)info, (const void *)(src + first), (k - first) * sizeof(elmtype));
+        } else {
+            std::uninitialized_copy_n(src, first, info + pos);
+            std::uninitialized_copy_n(src + first, k - first, info);
+        }
+        tail.store(t + k, std::memory_order_release);
+        return k;
+    }
+
+    /**
+     * @brief Removes up to n elements from the front of the ring buffer with a single publish. Consumer only.
+     * 
+     * @details The elements are moved out in at most two contiguous segments; trivially copyable elements are copied with memcpy.
+     *          Does nothing if n <= 0. Time complexity: O(n)
+     * 
+     * @param dst Receives the removed elements
+     * @param n The maximum number of elements to remove
+     * 
+     * @return The number of elements removed
+     */
+    int delFrontBatch(elmtype *dst, int n) {
+        if (n <= 0) {
+            return 0;
+        }
+        std::size_t h = head.load(std::memory_order_relaxed);
+        std::size_t avail = cachedTail - h;
+        if (avail < (std::size_t)n) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            avail = cachedTail - h;
+        }
+        int k = (int)std::min(avail, (std::size_t)n);
+        int pos = (int)(h & mask);
+        int first = std::min(k, (int)cap - pos);
+        if constexpr (std::is_trivially_copyable_v<elmtype>) {
+            std::memcpy((void *)dst, (const void *)(info + pos), first * sizeof(elmtype));
+            std::memcpy((void *)(dst + first), (const void *)info, (k - first) * sizeof(elmtype));
+        } else {
+            std::move(info + pos, info + pos + first, dst);
+            std::move(info, info + (k - first), dst + first);
+            std::destroy_n(info + pos, first);
+            std::destroy_n(info, k - first);
+        }
+        head.store(h + k, std::memory_order_release);
+        return k;
+    }
+
+    private:
+
+    /**
+     * @brief The capacity of the ring buffer, always a power of two
+     */
+    alignas(cacheLineSize) std::size_t cap;
+
+    /**
+     * @brief cap - 1, used to wrap the counters into indices
+     */
+    std::size_t mask;
+
+    /**
+     * @brief The ring buffer data, indexed by the wrapped head and tail counters
+     */
+    elmtype *info;
+
+    /**
+     * @brief The number of elements ever removed. Written by the consumer.
+     */
+    alignas(cacheLineSize) std::atomic<std::size_t> head = 0;
+
+    /**
+     * @brief The consumer's last seen value of tail
+     */
+    std::size_t cachedTail = 0;
+
+    /**
+     * @brief The number of elements ever added. Written by the producer.
+     */
+    alignas(cacheLineSize) std::atomic<std::size_t> tail = 0;
+
+    /**
+     * @brief The producer's last seen value of head
+     */
+    std::size_t cachedHead = 0;
+};
+
+/**
+ * @brief Implements a fixed capacity, lock-free multi-producer/multi-consumer ring buffer
+ * 
+ * @details Uses the circular dynamic array's ring layout with a power-of-two capacity. Every slot carries a sequence number that tells
+ *          producers and consumers whether the slot is free for the current lap of the ring, so each side only needs one compare-and-swap
+ *          on its own counter to claim a slot. The enqueue and dequeue counters live on separate cache lines.
+ * 
+ * @note Any number of threads may call addEnd and delFront concurrently.
+ * 
+ * @tparam elmtype The type of element stored in the ring buffer
+ */
+template <typename elmtype> class MPMCRingBuffer {
+
+    public:
+
+    /**
+     * @brief Constructs an empty ring buffer
+     * 
+     * @details The capacity is rounded up to a power of two, with a minimum of 2
+     * 
+     * @param capacity The number of elements the ring buffer can hold
+     */
+    MPMCRingBuffer(int capacity) {
+        cap = PowerOfTwoCapacity::fit(std::max(capacity, 2));
+        mask = cap - 1;
+        info = new Slot[cap];
+        for (std::size_t i = 0; i < cap; i++) {
+            info[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCRingBuffer(const MPMCRingBuffer &) = delete;
+    MPMCRingBuffer &operator=(const MPMCRingBuffer &) = delete;
+
+    /**
+     * @brief Destructor
+     * 
+     * @details Destroys the elements left in the ring buffer and frees the storage. No other thread may be using the ring buffer.
+     */
+    ~MPMCRingBuffer() {
+        std::size_t t = enqueuePos.load(std::memory_order_acquire);
+        for (std::size_t h = dequeuePos.load(std::memory_order_acquire); h != t; h++) {
+            std::destroy_at(info[h & mask].element());
+        }
+        delete[] info;
+    }
+
+    /**
+     * @brief Returns the number of elements in the ring buffer
+     * 
+     * @details The value is a snapshot while other threads are adding or removing elements
+     */
+    int length() {
+        std::size_t h = dequeuePos.load(std::memory_order_acquire);
+        std::size_t t = enqueuePos.load(std::memory_order_acquire);
+        return t > h ? (int)(t - h) : 0;
+    }
+
+    /**
+     * @brief Returns the capacity of the ring buffer
+     */
+    int capacity() { return (int)cap; }
+
+    /**
+     * @brief Adds a copy of an element to the end of the ring buffer
+     * 
+     * @details Time complexity: O(1), lock-free
+     * 
+     * @return True if the element was added, false if the ring buffer is full
+     */
+    bool addEnd(const elmtype &v) { return emplaceEnd(v); }
+
+    /**
+     * @brief Moves an element to the end of the ring buffer
+     * 
+     * @details Time complexity: O(1), lock-free
+     * 
+     * @return True if the element was added, false if the ring buffer is full
+     */
+    bool addEnd(elmtype &&v) { return emplaceEnd(std::move(v)); }
+
+    /**
+     * @brief Constructs an element in place at the end of the ring buffer
+     * 
+     * @details Time complexity: O(1), lock-free
+     * 
+     * @return True if the element was added, false if the ring buffer is full
+     */
+    template <typename... Args> bool emplaceEnd(Args &&...args) {
+        Slot *slot;
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &info[pos & mask];
+            std::size_t seq = slot->seq.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+            if (diff == 0) {
+                // The slot is free for this lap; claim it
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // The slot still holds the element from the previous lap
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        ::new ((void *)slot->element()) elmtype(std::forward<Args>(args)...);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the element at the front of the ring buffer
+     * 
+     * @details Time complexity: O(1), lock-free
+     * 
+     * @param out Receives the removed element
+     * 
+     * @return True if an element was removed, false if the ring buffer is empty
+     */
+    bool delFront(elmtype &out) {
+        Slot *slot;
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &info[pos & mask];
+            std::size_t seq = slot->seq.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+            if (diff == 0) {
+                // The slot was filled in this lap; claim it
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // No producer has filled the slot yet
+                return false;
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(*slot->element());
+        std::destroy_at(slot->element());
+        slot->seq.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    private:
+
+    /**
+     * @brief A ring buffer slot with its sequence number and uninitialized element storage
+     */
+    struct Slot {
+        /**
+         * @brief pos if the slot is free for the enqueue at pos, pos + 1 if it holds the element enqueued at pos
+         */
+        std::atomic<std::size_t> seq;
+
+        /**
+         * @brief Storage for the element
+         */
+        alignas(elmtype) unsigned char storage[sizeof(elmtype)];
+
+        elmtype *element() { return std::launder(reinterpret_cast<elmtype *>(storage)); }
+    };
+
+    /**
+     * @brief The capacity of the ring buffer, always a power of two
+     */
+    alignas(cacheLineSize) std::size_t cap;
+
+    /**
+     * @brief cap - 1, used to wrap the counters into indices
+     */
+    std::size_t mask;
+
+    /**
+     * @brief The ring buffer slots
+     */
+    Slot *info;
+
+    /**
+     * @brief The counter of the next slot to fill
+     */
+    alignas(cacheLineSize) std::atomic<std::size_t> enqueuePos = 0;
+
+    /**
+     * @brief The counter of the next slot to empty
+     */
+    alignas(cacheLineSize) std::atomic<std::size_t> dequeuePos = 0;
+};
+
+/**
+ * @brief Implements a d-ary Minimum Heap with a configurable comparator
+ * 
+ * @details The keys are stored in a circular dynamic array that is only appended to and trimmed at the end, so they stay in one
+ *          contiguous block that the sift loops walk with a plain pointer. The storage is aligned to a cache line and the root is preceded
+ *          by arity - 1 padding slots, which puts the children of every node (arity * i + 1 to arity * i + arity) at the start of an
+ *          aligned group; with arity * sizeof(keyType) <= 64 each group sits in a single cache line. Wider nodes make the heap shallower,
+ *          trading more comparisons per level for fewer levels and cache misses. The sifts move a hole instead of swapping, so each key is
+ *          written once per level.
+ * 
+ * @tparam keyType The type of key stored in the heap
+ * @tparam arity The number of children per node, 2 by default
+ * @tparam Compare The ordering of the keys; the heap keeps the smallest key first, so std::greater gives a maximum heap
+ */
+template<typename keyType, int arity = 2, typename Compare = std::less<keyType>> class Heap {
+
+    static_assert(arity >= 2, "A heap needs at least two children per node");
+
+    public:
+
+    /**
+     * @brief Default Constructor
+     */
+    Heap() : info(pad) {
+        info.reserve(firstLine);
+    }
+
+    /**
+     * @brief Constructs an empty heap that orders keys with comp
+     */
+    explicit Heap(const Compare &comp) : info(pad), comp(comp) {
+        info.reserve(firstLine);
+    }
+
+    /**
+     * @brief Constructs a heap with keys K and size s
+     * 
+     * @details Time complexity: O(s)
+     */
+    Heap(keyType K[], int s, const Compare &comp = Compare()) : info(s + pad), comp(comp) {
+        keyType *a = keys();
+        for (int i = 0; i < s; i++) {
+            a[i] = K[i];
+        }
+
+        heapify();
+    }
+
+    /**
+     * @brief Returns the size of the heap
+     */
+    int size() {
+        return info.length() - pad;
+    }
+
+    /**
+     * @brief Returns the minimum key in the heap
+     * 
+     * @details Returns a default constructed key if the heap is empty. Time complexity: O(1)
+     * 
+     * @return The minimum key
+     */
+    keyType peekKey() {
+        return size() > 0 ? keys()[0] : keyType();
+    }
+
+    /**
+     * @brief Inserts a new node with key k
+     * 
+     * @details Time complexity: O(log_arity(n)), n = size
+     * 
+     * @param k The key to insert
+     */
+    void insert(keyType k) {
+        info.addEnd(std::move(k));
+        siftUp(size() - 1);
+    }
+
+    /**
+     * @brief Replaces the minimum key with k and restores heap priority
+     * 
+     * @details Equivalent to extractMin followed by insert(k), with a single sift. Inserts k and returns a default constructed key if the
+     *          heap is empty. Time complexity: O(arity * log_arity(n)), n = size
+     * 
+     * @param k The key to insert
+     * 
+     * @return The old minimum key
+     */
+    keyType replaceMin(keyType k) {
+        if (size() == 0) {
+            insert(std::move(k));
+            return keyType();
+        }
+        keyType *a = keys();
+        keyType min = std::move(a[0]);
+        siftDown(a, size(), 0, k, comp);
+        return min;
+    }
+
+    /**
+     * @brief Inserts the keys of [first, last)
+     * 
+     * @details Appends the whole batch with one reserve, then either sifts each new key up or re-heapifies the new keys and their
+     *          ancestors. Sifting up costs about one comparison per key for random keys but log_arity(n) for keys that keep beating
+     *          the root, while the re-heapify costs O(m + log_arity(n)^2) whatever the order, so it takes over once the batch is at
+     *          least 1/batchHeapifyRatio of the heap. Input-only ranges are inserted one key at a time.
+     *          Time complexity: O(m + log_arity(n)^2) for large batches, O(m * log_arity(n)) otherwise, m = number of keys
+     * 
+     * @param first The iterator to the first key to insert
+     * @param last The iterator past the last key to insert
+     */
+    template <typename InputIt> void insertBatch(InputIt first, InputIt last) {
+        if constexpr (!std::forward_iterator<InputIt>) {
+            for (; first != last; ++first) {
+                insert(*first);
+            }
+        } else {
+            int old = size();
+            int m = (int)std::distance(first, last);
+            info.appendRange(first, last);
+            if ((long long)m * batchHeapifyRatio >= old) {
+                heapify(old);
+            } else {
+                for (int i = old; i < old + m; i++) {
+                    siftUp(i);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Inserts the keys of a span
+     * 
+     * @details See insertBatch(first, last).
+     */
+    void insertBatch(std::span<const keyType> s) { insertBatch(s.begin(), s.end()); }
+
+    /**
+     * @brief Removes the k smallest keys from the heap and returns them in sorted order
+     * 
+     * @details k is clamped to [0, size]. The keys are sifted out within the current storage and the array is trimmed once at the end,
+     *          instead of checking its capacity after every key. Time complexity: O(k * arity * log_arity(n)), n = size
+     * 
+     * @param k The number of keys to remove
+     * 
+     * @return The removed keys, smallest first
+     */
+    std::vector<keyType> extractMinBatch(int k) {
+        keyType *a = keys();
+        int n = size();
+        k = std::clamp(k, 0, n);
+        std::vector<keyType> result;
+        result.reserve(k);
+        for (int i = 0; i < k; i++) {
+            result.push_back(popRoot(a, n - i));
+        }
+        info.delEnd(k);
+        return result;
+    }
+
+    /**
+     * @brief Removes every key that orders before k and returns them in sorted order
+     * 
+     * @details Like extractMinBatch, the keys are sifted out within the current storage and the array is trimmed once at the end.
+     *          Time complexity: O(c * arity * log_arity(n)), c = number of keys removed, n = size
+     * 
+     * @param k The bound; keys equal to it stay in the heap
+     * 
+     * @return The removed keys, smallest first
+     */
+    std::vector<keyType> popUntil(const keyType &k) {
+        keyType *a = keys();
+        int n = size();
+        int c = 0;
+        std::vector<keyType> result;
+        while (c < n && comp(a[0], k)) {
+            result.push_back(popRoot(a, n - c));
+            c++;
+        }
+        info.delEnd(c);
+        return result;
+    }
+
+    /**
+     * @brief Sorts the n keys at a in place, in ascending order under Compare
+     * 
+     * @details Heapsort on the caller's buffer with the same heapify and bottom-up siftDown the heap uses, so it allocates nothing.
+     *          The keys are heapified with the largest at the root, then each step moves the root behind the unsorted part and sifts
+     *          the key it displaced in from the root. Not stable. Time complexity: O(n * arity * log_arity(n))
+     * 
+     * @param a The keys to sort
+     * @param n The number of keys
+     * @param comp The ordering of the keys, defaulting to Compare()
+     */
+    static void heapSort(keyType *a, int n, Compare comp = Compare()) {
+        Reversed rev{comp};
+        heapify(a, n, 0, rev);
+        for (int end = n - 1; end > 0; end--) {
+            keyType v = std::move(a[end]);
+            a[end] = std::move(a[0]);
+            siftDown(a, end, 0, v, rev);
+        }
+    }
+
+    /**
+     * @brief Sorts the keys of a span in place
+     * 
+     * @details See heapSort(a, n, comp).
+     */
+    static void heapSort(std::span<keyType> s, Compare comp = Compare()) { heapSort(s.data(), (int)s.size(), comp); }
+
+    /**
+     * @brief Prints all keys in the heap in level order
+     * 
+     * @param out The output stream to print to, defaulting to std::cout
+     */
+    void printKeys(std::ostream &out = std::cout) {
+        keyType *a = keys();
+        for (int i = 0; i < size(); i++) {
+            out << a[i];
+            if (i != size() - 1) {
+                out << " ";
+            }
+        }
+        if (size() != 0) {out << std::endl;}
+    }
+
+    /**
+     * @brief Removes the minimum key from the heap and restores heap priority
+     * 
+     * @details Returns a default constructed key if the heap is empty. Time complexity: O(arity * log_arity(n)), n = size
+     * 
+     * @return The minimum key
+     */
+    keyType extractMin() {
+        if (size() == 0) {
+            return keyType();
+        }
+        keyType min = popRoot(keys(), size());
+        info.delEnd();
+        return min;
+    }
+
+    private:
+
+    /**
+     * @brief The number of padding slots in front of the root
+     */
+    static constexpr int pad = arity - 1;
+
+    /**
+     * @brief The capacity an empty heap reserves: a cache line of keys, and at least the padding, root and its children
+     */
+    static constexpr int firstLine = std::max<int>(cacheLineSize / sizeof(keyType), arity + pad);
+
+    /**
+     * @brief insertBatch re-heapifies instead of sifting up once the batch is at least 1/batchHeapifyRatio of the heap
+     */
+    static constexpr int batchHeapifyRatio = 2;
+
+    /**
+     * @brief The array that stores the heap: pad unused slots, then the keys in level order
+     */
+    CircularDynamicArray<keyType, ModuloCapacity, CacheAlignedAllocator<keyType>> info;
+
+    /**
+     * @brief The ordering of the keys
+     */
+    [[no_unique_address]] Compare comp;
+
+    /**
+     * @brief Returns a pointer to the root; the other keys follow it contiguously
+     */
+    keyType *keys() {
+        return info.segments().first.data() + pad;
+    }
+
+    /**
+     * @brief Moves the root out of the n keys at a and refills it with the last key, leaving a heap of n - 1 keys
+     * 
+     * @details The caller trims the array afterwards, so several roots can be popped before a single delEnd.
+     *          Time complexity: O(arity * log_arity(n))
+     * 
+     * @param a The keys in level order
+     * @param n The number of keys, at least 1
+     * 
+     * @return The old root
+     */
+    keyType popRoot(keyType *a, int n) {
+        keyType min = std::move(a[0]);
+        if (n > 1) {
+            keyType last = std::move(a[n - 1]);
+            siftDown(a, n - 1, 0, last, comp);
+        }
+        return min;
+    }
+
+    /**
+     * @brief Restores heap order after the keys from index first onwards were appended without sifting
+     * 
+     * @details Sifts down, bottom up, every internal node at or after first and every ancestor of those nodes; the rest of the tree is
+     *          already a heap. Each pass moves the dirty index range up one level and drops the part of it that was already sifted, so
+     *          every node is sifted once and before its parent. With first = 0 this is Floyd's heap construction.
+     *          Time complexity: O(m + log_arity(n)^2), m = n - first
+     * 
+     * @param first The index of the first unsifted key
+     */
+    void heapify(int first = 0) { heapify(keys(), size(), first, comp); }
+
+    /**
+     * @brief Restores heap order among the n keys at a after the keys from index first onwards were stored without sifting
+     * 
+     * @details See heapify(first). Time complexity: O(m + log_arity(n)^2), m = n - first
+     * 
+     * @param a The keys in level order
+     * @param n The number of keys
+     * @param first The index of the first unsifted key
+     * @param comp The ordering of the keys
+     */
+    template<typename Cmp>
+    static void heapify(keyType *a, int n, int first, Cmp &comp) {
+        if (n < 2 || first >= n) {
+            return;
+        }
+        int lastInternal = pIndex(n - 1);
+        int lo = first;
+        int hi = n - 1;
+        while (true) {
+            for (int i = std::min(hi, lastInternal); i >= lo; i--) {
+                keyType v = std::move(a[i]);
+                siftDown(a, n, i, v, comp);
+            }
+            if (lo == 0) {
+                break;
+            }
+            hi = std::min(pIndex(hi), lo - 1);
+            lo = pIndex(lo);
+        }
+    }
+
+    /**
+     * @brief Sifts the key at index i up in the heap
+     * 
+     * @details Time complexity: O(log_arity(n))
+     * 
+     * @param i The index of the node to sift up
+     */
+    void siftUp(int i) {
+        keyType *a = keys();
+        keyType v = std::move(a[i]);
+        while (i > 0) {
+            int p = pIndex(i);
+            if (!comp(v, a[p])) {
+                break;
+            }
+            a[i] = std::move(a[p]);
+            i = p;
+        }
+        a[i] = std::move(v);
+    }
+
+    /**
+     * @brief Moves the hole at index i down to where v belongs among the n keys at a, then stores v there
+     * 
+     * @details Bottom-up: the hole first follows the smallest children (ties go to the leftmost) all the way to a leaf without comparing
+     *          against v, then v rises from there. The key being placed is usually the old last leaf, so it rarely rises more than a
+     *          level, which saves most of the comparisons against v. With two children the choice is written as a single branch rather than
+     *          a scan, which keeps it a predicted branch so the next level's loads can start early on heaps larger than the cache.
+     *          Time complexity: O(arity * log_arity(n))
+     * 
+     * @param a The keys in level order
+     * @param n The number of keys
+     * @param i The index of the hole
+     * @param v The key to place, moved from
+     * @param comp The ordering of the keys
+     */
+    template<typename Cmp>
+    static void siftDown(keyType *a, int n, int i, keyType &v, Cmp &comp) {
+        int top = i;
+        for (int c = cIndex(i); c < n; c = cIndex(i)) {
+            int best = c;
+            if constexpr (arity == 2) {
+                if (c + 1 < n && comp(a[c + 1], a[c])) {
+                    best = c + 1;
+                }
+            } else {
+                int last = std::min(c + arity, n);
+                for (int j = c + 1; j < last; j++) {
+                    if (comp(a[j], a[best])) {
+                        best = j;
+                    }
+                }
+            }
+            a[i] = std::move(a[best]);
+            i = best;
+        }
+        while (i > top) {
+            int p = pIndex(i);
+            if (!comp(v, a[p])) {
+                break;
+            }
+            a[i] = std::move(a[p]);
+            i = p;
+        }
+        a[i] = std::move(v);
+    }
+
+    /**
+     * @brief Returns the index of the parent of the node at index i
+     * 
+     * @details Time complexity: O(1)
+     * 
+     * @param i The index of the node
+     * 
+     * @return The index of the parent
+     */
+    static int pIndex(int i) {
+        return (i - 1) / arity;
+    }
+
+    /**
+     * @brief Returns the index of the first child of the node at index i
+     * 
+     * @details Time complexity: O(1)
+     * 
+     * @param i The index of the node
+     * 
+     * @return The index of the first child; the other children follow it
+     */
+    static int cIndex(int i) {
+        return arity * i + 1;
+    }
+
+    /**
+     * @brief Compare with its arguments swapped, so heapSort can build a heap with the largest key at the root
+     */
+    struct Reversed {
+        Compare &comp;
+
+        bool operator()(const keyType &x, const keyType &y) { return comp(y, x); }
+    };
+};
+
+/**
+ * @brief Implements a d-ary Minimum Heap whose keys carry a payload that the sifts never move
+ * 
+ * @details The heap is a Heap of compact entries, each a key and the index of its payload in a separate store, so a sift moves only
+ *          those entries however large the payload is. A payload is moved into the store once on insert and out of it once on
+ *          extractMin. Slots freed by extractMin go on a free list and are reused by later inserts, so the store grows with the
+ *          largest number of payloads held at once rather than with the number of inserts.
+ * 
+ * @tparam keyType The type of key the heap is ordered by
+ * @tparam payloadType The type of value stored with each key
+ * @tparam arity The number of children per node, 2 by default
+ * @tparam Compare The ordering of the keys; the heap keeps the smallest key first, so std::greater gives a maximum heap
+ */
+template<typename keyType, typename payloadType, int arity = 2, typename Compare = std::less<keyType>> class PayloadHeap {
+
+    public:
+
+    /**
+     * @brief Default Constructor
+     */
+    PayloadHeap() {}
+
+    /**
+     * @brief Constructs an empty heap that orders keys with comp
+     */
+    explicit PayloadHeap(const Compare &comp) : entries(ByKey{comp}) {}
+
+    /**
+     * @brief Returns the size of the heap
+     */
+    int size() {
+        return entries.size();
+    }
+
+    /**
+     * @brief Returns the minimum key in the heap
+     * 
+     * @details Returns a default constructed key if the heap is empty. Time complexity: O(1)
+     * 
+     * @return The minimum key
+     */
+    keyType peekKey() {
+        return size() > 0 ? entries.peekKey().key : keyType();
+    }
+
+    /**
+     * @brief Returns a reference to the payload of the minimum key
+     * 
+     * @details Returns the burner payload if the heap is empty. Time complexity: O(1)
+     * 
+     * @return The payload, which stays in the heap
+     */
+    payloadType &peekPayload() {
+        return size() > 0 ? payloads[entries.peekKey().slot] : burner;
+    }
+
+    /**
+     * @brief Inserts key k with payload p
+     * 
+     * @details Reuses a freed payload slot if there is one. Time complexity: O(log_arity(n)), n = size
+     * 
+     * @param k The key to insert
+     * @param p The payload, moved into the store
+     */
+    void insert(keyType k, payloadType p) {
+        int slot;
+        if (freeSlots.length() > 0) {
+            slot = freeSlots[freeSlots.length() - 1];
+            freeSlots.delEnd();
+            payloads[slot] = std::move(p);
+        } else {
+            slot = payloads.length();
+            payloads.addEnd(std::move(p));
+        }
+        entries.insert(Entry{std::move(k), slot});
+    }
+
+    /**
+     * @brief Removes the minimum key from the heap and returns it with its payload
+     * 
+     * @details Returns a default constructed pair if the heap is empty. Time complexity: O(arity * log_arity(n)), n = size
+     * 
+     * @return The minimum key and its payload
+     */
+    std::pair<keyType, payloadType> extractMin() {
+        if (size() == 0) {
+            return std::pair<keyType, payloadType>();
+        }
+        Entry e = entries.extractMin();
+        std::pair<keyType, payloadType> result(std::move(e.key), std::move(payloads[e.slot]));
+        freeSlots.addEnd(e.slot);
+        return result;
+    }
+
+    private:
+
+    /**
+     * @brief A key and the index of its payload in the store
+     */
+    struct Entry {
+        keyType key;
+        int slot;
+    };
+
+    /**
+     * @brief Orders entries by their keys
+     */
+    struct ByKey {
+        [[no_unique_address]] Compare comp;
+
+        bool operator()(const Entry &x, const Entry &y) { return comp(x.key, y.key); }
+    };
+
+    /**
+     * @brief The heap of keys and payload indices
+     */
+    Heap<Entry, arity, ByKey> entries;
+
+    /**
+     * @brief The payloads, indexed by Entry::slot
+     */
+    CircularDynamicArray<payloadType> payloads;
+
+    /**
+     * @brief The payload slots not in use
+     */
+    CircularDynamicArray<int> freeSlots;
+
+    /**
+     * @brief Returned by peekPayload when the heap is empty
+     */
+    payloadType burner = payloadType();
+};
+
+/**
+ * @brief Implements a d-ary Minimum Heap whose keys can be changed or removed through stable handles
+ * 
+ * @details insert returns a handle that names the key until it is extracted or erased; after that the handle may be given to a later
+ *          insert. Each heap slot stores its key next to its handle, so the sifts compare keys without an extra indirection, and a
+ *          position map from handle to slot is updated every time a slot moves. Handles of removed keys go on a free list, so the map
+ *          grows with the largest number of keys held at once rather than with the number of inserts.
+ * 
+ * @tparam keyType The type of key stored in the heap
+ * @tparam arity The number of children per node, 2 by default
+ * @tparam Compare The ordering of the keys; the heap keeps the smallest key first, so std::greater gives a maximum heap
  */
-template <typename elmtype> class CircularDynamicArray {
+template<typename keyType, int arity = 2, typename Compare = std::less<keyType>> class IndexedHeap {
+
+    static_assert(arity >= 2, "A heap needs at least two children per node");
+
+    public:
+
+    /**
+     * @brief Default Constructor
+     */
+    IndexedHeap() {}
+
+    /**
+     * @brief Constructs an empty heap that orders keys with comp
+     */
+    explicit IndexedHeap(const Compare &comp) : comp(comp) {}
+
+    /**
+     * @brief Returns the size of the heap
+     */
+    int size() {
+        return slots.length();
+    }
+
+    /**
+     * @brief Returns whether handle h names a key in the heap
+     * 
+     * @details Time complexity: O(1)
+     */
+    bool contains(int h) {
+        return h >= 0 && h < pos.length() && pos[h] >= 0;
+    }
+
+    /**
+     * @brief Returns the key named by handle h
+     * 
+     * @details Returns a default constructed key if the handle is not in the heap. Time complexity: O(1)
+     */
+    keyType key(int h) {
+        return contains(h) ? slots[pos[h]].key : keyType();
+    }
+
+    /**
+     * @brief Returns the minimum key in the heap
+     * 
+     * @details Returns a default constructed key if the heap is empty. Time complexity: O(1)
+     * 
+     * @return The minimum key
+     */
+    keyType peekKey() {
+        return size() > 0 ? slots[0].key : keyType();
+    }
+
+    /**
+     * @brief Returns the handle of the minimum key in the heap
+     * 
+     * @details Time complexity: O(1)
+     * 
+     * @return The handle, or -1 if the heap is empty
+     */
+    int peekHandle() {
+        return size() > 0 ? slots[0].handle : -1;
+    }
+
+    /**
+     * @brief Inserts a new node with key k
+     * 
+     * @details Reuses the handle of a removed key if there is one. Time complexity: O(log_arity(n)), n = size
+     * 
+     * @param k The key to insert
+     * 
+     * @return The handle of the new key
+     */
+    int insert(keyType k) {
+        int h;
+        if (freeHandles.length() > 0) {
+            h = freeHandles[freeHandles.length() - 1];
+            freeHandles.delEnd();
+        } else {
+            h = pos.length();
+            pos.addEnd(-1);
+        }
+        slots.addEnd(Slot{std::move(k), h});
+        int n = size();
+        siftUp(entries(), positions(), n - 1);
+        return h;
+    }
+
+    /**
+     * @brief Removes the minimum key from the heap and restores heap priority
+     * 
+     * @details The handle of the minimum key is released. Returns a default constructed key if the heap is empty.
+     *          Time complexity: O(arity * log_arity(n)), n = size
+     * 
+     * @return The minimum key
+     */
+    keyType extractMin() {
+        if (size() == 0) {
+            return keyType();
+        }
+        keyType min = std::move(slots[0].key);
+        removeAt(0);
+        return min;
+    }
+
+    /**
+     * @brief Lowers the key named by handle h to k and moves it up
+     * 
+     * @details Time complexity: O(log_arity(n)), n = size
+     * 
+     * @param h The handle of the key
+     * @param k The new key, which must not order after the current one
+     * 
+     * @return 1 if the key was changed, 0 if the handle is not in the heap or k orders after the current key
+     */
+    int decreaseKey(int h, keyType k) {
+        if (!contains(h) || comp(slots[pos[h]].key, k)) {
+            return 0;
+        }
+        int *p = positions();
+        Slot *a = entries();
+        a[p[h]].key = std::move(k);
+        siftUp(a, p, p[h]);
+        return 1;
+    }
+
+    /**
+     * @brief Raises the key named by handle h to k and moves it down
+     * 
+     * @details Time complexity: O(arity * log_arity(n)), n = size
+     * 
+     * @param h The handle of the key
+     * @param k The new key, which must not order before the current one
+     * 
+     * @return 1 if the key was changed, 0 if the handle is not in the heap or k orders before the current key
+     */
+    int increaseKey(int h, keyType k) {
+        if (!contains(h) || comp(k, slots[pos[h]].key)) {
+            return 0;
+        }
+        int *p = positions();
+        Slot *a = entries();
+        int i = p[h];
+        Slot v{std::move(k), h};
+        siftDown(a, p, size(), i, v);
+        return 1;
+    }
+
+    /**
+     * @brief Removes the key named by handle h and releases the handle
+     * 
+     * @details Time complexity: O(arity * log_arity(n)), n = size
+     * 
+     * @param h The handle of the key
+     * 
+     * @return 1 if the key was removed, 0 if the handle is not in the heap
+     */
+    int erase(int h) {
+        if (!contains(h)) {
+            return 0;
+        }
+        removeAt(pos[h]);
+        return 1;
+    }
+
+    /**
+     * @brief Prints all keys in the heap in level order
+     * 
+     * @param out The output stream to print to, defaulting to std::cout
+     */
+    void printKeys(std::ostream &out = std::cout) {
+        for (int i = 0; i < size(); i++) {
+            out << slots[i].key;
+            if (i != size() - 1) {
+                out << " ";
+            }
+        }
+        if (size() != 0) {out << std::endl;}
+    }
+
+    private:
+
+    /**
+     * @brief A heap slot: a key and the handle that names it
+     */
+    struct Slot {
+        keyType key = keyType();
+        int handle = -1;
+    };
 
-   public:
     /**
-     * @brief Default Constructor
+     * @brief The slots in level order
+     */
+    CircularDynamicArray<Slot> slots;
+
+    /**
+     * @brief The slot index of each handle, or -1 for released handles
+     */
+    CircularDynamicArray<int> pos;
+
+    /**
+     * @brief Released handles, reused last in, first out
+     */
+    CircularDynamicArray<int> freeHandles;
+
+    /**
+     * @brief The ordering of the keys
+     */
+    [[no_unique_address]] Compare comp;
+
+    /**
+     * @brief Returns a pointer to the root slot; the arrays are only grown and trimmed at the end, so they stay contiguous
+     */
+    Slot *entries() {
+        return slots.segments().first.data();
+    }
+
+    /**
+     * @brief Returns a pointer to the position of handle 0
+     */
+    int *positions() {
+        return pos.segments().first.data();
+    }
+
+    /**
+     * @brief Removes the slot at index i, fills the gap with the last slot and releases the removed handle
      * 
-     * @details Initializes the circular dynamic array with a capacity of 2. End is set to -1 for addEnd() and addFront() functionality.
+     * @details Time complexity: O(arity * log_arity(n)), n = size
+     * 
+     * @param i The index of the slot to remove
      */
-    CircularDynamicArray() {
-        cap = 2;
-        size = 0;
-        start = 0;
-        end = -1;
-        info = new elmtype[2];
+    void removeAt(int i) {
+        Slot *a = entries();
+        int *p = positions();
+        int h = a[i].handle;
+        p[h] = -1;
+        freeHandles.addEnd(h);
+        int n = size() - 1;
+        if (i == n) {
+            slots.delEnd();
+            return;
+        }
+        Slot last = std::move(a[n]);
+        // Removing the last slot may move the storage
+        slots.delEnd();
+        a = entries();
+        if (i > 0 && comp(last.key, a[pIndex(i)].key)) {
+            a[i] = std::move(last);
+            p[a[i].handle] = i;
+            siftUp(a, p, i);
+        } else {
+            siftDown(a, p, n, i, last);
+        }
     }
 
     /**
-     * @brief Constructor for a set capacity
+     * @brief Sifts the slot at index i up in the heap, updating the positions of every slot it passes
      * 
-     * @details Initializes the circular dynamic array with a set capacity. End is set to capacity - 1 for addEnd() and addFront() functionality.
+     * @details Time complexity: O(log_arity(n))
      * 
-     * @param capacity The capacity of the circular dynamic array
+     * @param a The slots in level order
+     * @param p The position map
+     * @param i The index of the slot to sift up
      */
-    CircularDynamicArray(int capacity) {
-        cap = capacity;
-        size = capacity;
-        start = 0;
-        end = capacity - 1;
-        info = new elmtype[capacity];
-    };
+    void siftUp(Slot *a, int *p, int i) {
+        Slot v = std::move(a[i]);
+        while (i > 0) {
+            int parent = pIndex(i);
+            if (!comp(v.key, a[parent].key)) {
+                break;
+            }
+            a[i] = std::move(a[parent]);
+            p[a[i].handle] = i;
+            i = parent;
+        }
+        a[i] = std::move(v);
+        p[a[i].handle] = i;
+    }
 
     /**
-     * @brief Copy constructor (deep copy)
+     * @brief Moves the hole at index i down to where v belongs among the n slots at a, then stores v there
      * 
-     * @details Deep copies all values from the source circular dynamic array
+     * @details Top-down, since v is an arbitrary key rather than a leaf; the hole stops as soon as no child orders before v.
+     *          Time complexity: O(arity * log_arity(n))
      * 
-     * @param src The source circular dynamic array to copy
+     * @param a The slots in level order
+     * @param p The position map
+     * @param n The number of slots
+     * @param i The index of the hole
+     * @param v The slot to place, moved from
      */
-    CircularDynamicArray(CircularDynamicArray const &src) {
-        cap = src.cap;
-        size = src.size;
-        start = src.start;
-        end = src.end;
-        elmtype *tempInfo = new elmtype[cap];
-        for (int i = 0; i < cap; i++) {
-            tempInfo[i] = src.info[i];
+    void siftDown(Slot *a, int *p, int n, int i, Slot &v) {
+        for (int c = cIndex(i); c < n; c = cIndex(i)) {
+            int best = c;
+            int last = std::min(c + arity, n);
+            for (int j = c + 1; j < last; j++) {
+                if (comp(a[j].key, a[best].key)) {
+                    best = j;
+                }
+            }
+            if (!comp(a[best].key, v.key)) {
+                break;
+            }
+            a[i] = std::move(a[best]);
+            p[a[i].handle] = i;
+            i = best;
         }
-        info = tempInfo;
+        a[i] = std::move(v);
+        p[a[i].handle] = i;
     }
-    
+
     /**
-     * @brief Destructor
+     * @brief Returns the index of the parent of the node at index i
+     */
+    static int pIndex(int i) {
+        return (i - 1) / arity;
+    }
+
+    /**
+     * @brief Returns the index of the first child of the node at index i; the other children follow it
+     */
+    static int cIndex(int i) {
+        return arity * i + 1;
+    }
+};
+
+/**
+ * @brief Implements a Minimum Pairing Heap with O(1) meld and amortized decreaseKey
+ * 
+ * @details A heap-ordered multiway tree stored as first-child/next-sibling links. insert and meld link two roots with one comparison;
+ *          extractMin pairs the root's children left to right and then melds the pairs right to left. Nodes come from a pool owned by the
+ *          heap: chunks of nodes are allocated together, and removed nodes go on a free list for the next insert instead of back to the
+ *          global heap. meld takes over the other heap's chunks and free list along with its tree, so handles from either heap stay valid.
+ *          The heap can be moved but not copied.
+ * 
+ * @tparam keyType The type of key stored in the heap
+ * @tparam Compare The ordering of the keys; the heap keeps the smallest key first, so std::greater gives a maximum heap
+ */
+template<typename keyType, typename Compare = std::less<keyType>> class PairingHeap {
+
+    struct Node;
+
+    public:
+
+    /**
+     * @brief Names a key in the heap for decreaseKey
      * 
-     * @details Deletes the array data
+     * @details Valid until the key is extracted, including after the heap is melded into another one.
      */
-    ~CircularDynamicArray() { if (info != nullptr) {delete[] info;} };
+    class Handle {
+        friend class PairingHeap;
+        Node *node = nullptr;
+        explicit Handle(Node *node) : node(node) {}
+
+        public:
+
+        Handle() = default;
+        bool operator==(const Handle &) const = default;
+    };
 
     /**
-     * @brief Returns the size of the array
+     * @brief Default Constructor
      */
-    int length() { return size; }
+    PairingHeap() {}
 
     /**
-     * @brief Returns the capacity of the array
+     * @brief Constructs an empty heap that orders keys with comp
      */
-    int capacity() { return cap; }
-    
+    explicit PairingHeap(const Compare &comp) : comp(comp) {}
+
+    PairingHeap(const PairingHeap &) = delete;
+    PairingHeap &operator=(const PairingHeap &) = delete;
+
     /**
-     * @brief Returns the value of the element at index i
+     * @brief Move Constructor. Takes over the tree and the node pool of src, leaving it empty.
      */
-    elmtype atRef(int i) {
-        if (i < 0 || i > cap) {
-            return burner;
-        }
-        return info[(i + start) % cap];
+    PairingHeap(PairingHeap &&src) noexcept : comp(src.comp) {
+        take(src);
     }
-    
+
     /**
-     * @brief Returns a pointer to the element at index i
+     * @brief Move Assignment Operator. Releases this heap, then takes over the tree and the node pool of src.
      */
-    elmtype *atPoint(int i) {
-        if (i < 0 || i > cap) {
-            return &burner;
+    PairingHeap &operator=(PairingHeap &&src) noexcept {
+        if (this != &src) {
+            release();
+            comp = src.comp;
+            take(src);
         }
-        return &info[(i + start) % cap];
+        return *this;
     }
 
     /**
-     * @brief Bracket operator. Returns burner element if index is invalid.
+     * @brief Destructor. Destroys the keys and frees every chunk of nodes.
      */
-    elmtype &operator[](int i) {
-        if (i < 0 || i > cap) {
-            return burner;
-        }
-        return info[(i + start) % cap];
+    ~PairingHeap() {
+        release();
     }
 
     /**
-     * @brief Equals operator. Deep copies all values.
+     * @brief Returns the size of the heap
      */
-    CircularDynamicArray &operator=(const CircularDynamicArray &R) {
-        cap = R.cap;
-        size = R.size;
-        start = R.start;
-        end = R.end;
-        delete[] info;
-        info = new elmtype[cap];
-        for (int i = 0; i < cap; i++) {
-            info[i] = R.info[i];
+    int size() {
+        return count;
+    }
+
+    /**
+     * @brief Returns the minimum key in the heap
+     * 
+     * @details Returns a default constructed key if the heap is empty. Time complexity: O(1)
+     * 
+     * @return The minimum key
+     */
+    keyType peekKey() {
+        return root ? root->key : keyType();
+    }
+
+    /**
+     * @brief Inserts a new node with key k
+     * 
+     * @details Time complexity: O(1)
+     * 
+     * @param k The key to insert
+     * 
+     * @return The handle of the new key
+     */
+    Handle insert(keyType k) {
+        Node *n = newNode();
+        std::construct_at(&n->key, std::move(k));
+        root = root ? link(root, n) : n;
+        count++;
+        return Handle(n);
+    }
+
+    /**
+     * @brief Removes the minimum key from the heap and restores heap priority
+     * 
+     * @details Returns a default constructed key if the heap is empty. Time complexity: O(log(n)) amortized, n = size
+     * 
+     * @return The minimum key
+     */
+    keyType extractMin() {
+        if (!root) {
+            return keyType();
         }
-        return *this;
+        Node *old = root;
+        keyType min = std::move(old->key);
+        root = mergePairs(old->child);
+        if (root) {
+            root->prev = nullptr;
+        }
+        freeNode(old);
+        count--;
+        return min;
     }
 
     /**
-     * @brief Adds an element to the front of the array
+     * @brief Lowers the key named by handle h to k
      * 
-     * @details Time complexity: O(1) (Amortized)
+     * @details Cuts the node's subtree out of its parent's child list and links it with the root. h must name a key in the heap.
+     *          Time complexity: O(1) to cut and link, O(log(n)) amortized, n = size
+     * 
+     * @param h The handle of the key
+     * @param k The new key, which must not order after the current one
+     * 
+     * @return 1 if the key was changed, 0 if k orders after the current key
      */
-    void addFront(elmtype v) {
-        checkCapIncrease();
-        if (start > 0) {
-            info[start - 1] = v;
+    int decreaseKey(Handle h, keyType k) {
+        Node *n = h.node;
+        if (comp(n->key, k)) {
+            return 0;
+        }
+        n->key = std::move(k);
+        if (n == root) {
+            return 1;
+        }
+        if (n->prev->child == n) {
+            n->prev->child = n->next;
         } else {
-            info[cap - 1] = v;
-            start = cap;
+            n->prev->next = n->next;
         }
-        start--;
-        size++;
-    };
+        if (n->next) {
+            n->next->prev = n->prev;
+        }
+        n->next = nullptr;
+        n->prev = nullptr;
+        root = link(root, n);
+        return 1;
+    }
 
     /**
-     * @brief Adds an element to the end of the array
+     * @brief Moves every key of other into this heap, leaving other empty
      * 
-     * @details Time complexity: O(1) (Amortized)
+     * @details Links the two roots and splices other's chunk list and free list onto this heap's, so no key is copied and handles into
+     *          other now name keys in this heap. Both heaps must order keys the same way. Time complexity: O(1)
+     * 
+     * @param other The heap to meld into this one
      */
-    void addEnd(elmtype v) {
-        checkCapIncrease();
-        info[(end + 1) % cap] = v;
-        end++;
-        end %= cap;
-        size++;
+    void meld(PairingHeap &other) {
+        if (this == &other) {
+            return;
+        }
+        if (other.root) {
+            root = root ? link(root, other.root) : other.root;
+        }
+        count += other.count;
+        if (other.chunks) {
+            other.lastChunk->next = chunks;
+            chunks = other.chunks;
+            if (!lastChunk) {
+                lastChunk = other.lastChunk;
+            }
+        }
+        if (other.freeList) {
+            other.freeTail->next = freeList;
+            freeList = other.freeList;
+            if (!freeTail) {
+                freeTail = other.freeTail;
+            }
+        }
+        other.reset();
     }
 
+    private:
+
     /**
-     * @brief Removes the element at the front of the array
+     * @brief A tree node. prev is the parent for a first child and the previous sibling otherwise.
      * 
-     * @details Time complexity: O(1) (Amortized)
+     * @details The key lives in a union so that pooled nodes can exist without one; it is constructed by insert and destroyed when the
+     *          node is freed.
      */
-    void delFront() {
-        start++;
-        start %= cap;
-        size--;
-        checkCapDecrease();
+    struct Node {
+        Node *child = nullptr;
+        Node *next = nullptr;
+        Node *prev = nullptr;
+        union {
+            keyType key;
+        };
+
+        Node() {}
+        ~Node() {}
     };
 
     /**
-     * @brief Removes the element at the end of the array
-     * 
-     * @details Time complexity: O(1) (Amortized)
+     * @brief The number of nodes allocated together, about a page
      */
-    void delEnd() {
-        end--;
-        if (end == -1) {
-            end = cap - 1;
-        }
-        size--;
-        checkCapDecrease();
-    };
+    static constexpr int chunkNodes = std::max<int>(16, 4096 / sizeof(Node));
 
     /**
-     * @brief Clears all array data and resets the array to its default state
+     * @brief A block of pooled nodes, linked to the other blocks of the heap
      */
-    void clear() {
-        size = 0;
-        cap = 2;
-        start = 0;
-        end = -1;
-        delete[] info;
-        info = new elmtype[cap];
+    struct Chunk {
+        Chunk *next = nullptr;
+        Node nodes[chunkNodes];
     };
 
     /**
-     * @brief Swaps two elements
+     * @brief The root of the tree
      */
-    void swap(elmtype *a, elmtype *b) {
-        elmtype temp = (*a);
-        (*a) = (*b);
-        (*b) = temp;
-    }
+    Node *root = nullptr;
 
     /**
-     * @brief Returns the Kth smallest element of the array using the median as the partition element
-     * 
-     * @details Time complexity: O(size)
-     * 
-     * @param k The index of the element to find
+     * @brief The number of keys in the heap
+     */
+    int count = 0;
+
+    /**
+     * @brief The chunks of nodes owned by the heap; lastChunk lets meld splice in O(1)
+     */
+    Chunk *chunks = nullptr;
+    Chunk *lastChunk = nullptr;
+
+    /**
+     * @brief Unused nodes, linked through next; freeTail lets meld splice in O(1)
+     */
+    Node *freeList = nullptr;
+    Node *freeTail = nullptr;
+
+    /**
+     * @brief The ordering of the keys
+     */
+    [[no_unique_address]] Compare comp;
+
+    /**
+     * @brief Makes the root with the larger key the first child of the other and returns the new root
      * 
-     * @return The Kth smallest element of the array
+     * @details Time complexity: O(1)
      */
-    elmtype QuickSelect(int k) {
-        if (k <= 0 || k > size) {
-            return burner;
+    Node *link(Node *a, Node *b) {
+        if (comp(b->key, a->key)) {
+            std::swap(a, b);
         }
-        return select(k, standard);
+        b->next = a->child;
+        if (a->child) {
+            a->child->prev = b;
+        }
+        b->prev = a;
+        a->child = b;
+        a->next = nullptr;
+        return a;
     }
 
     /**
-     * @brief Returns the Kth smallest element of the array using the median of medians (subarray size = 5) as the partition element
+     * @brief Melds a list of siblings into one tree with the two-pass pairing rule and returns its root
      * 
-     * @details Time complexity: O(size)
-     * 
-     * @param k The index of the element to find
+     * @details The first pass links neighbours left to right and stacks the results through next; the second pass pops them, so the
+     *          pairs are melded right to left. Time complexity: O(k), k = number of siblings
      * 
-     * @return The Kth smallest element of the array
+     * @param first The leftmost sibling, or nullptr
      */
-    elmtype WCSelect(int k) {
-        if (k <= 0 || k > size) {
-            return burner;
+    Node *mergePairs(Node *first) {
+        Node *pairs = nullptr;
+        while (first) {
+            Node *a = first;
+            Node *b = a->next;
+            if (!b) {
+                a->next = pairs;
+                pairs = a;
+                break;
+            }
+            first = b->next;
+            Node *m = link(a, b);
+            m->next = pairs;
+            pairs = m;
+        }
+        Node *result = pairs;
+        if (result) {
+            pairs = result->next;
+            result->next = nullptr;
         }
-        return select(k, worstCase);
+        while (pairs) {
+            Node *n = pairs->next;
+            result = link(result, pairs);
+            pairs = n;
+        }
+        return result;
     }
 
     /**
-     * @brief Performs a mergesort on the array
+     * @brief Takes a node from the free list, allocating a new chunk if it is empty
      * 
-     * @details Time complexity: O(size * lg(size))
+     * @details Time complexity: O(1) amortized
      */
-    void stableSort() { mergeSort(0, size - 1); };
+    Node *newNode() {
+        if (!freeList) {
+            Chunk *c = new Chunk;
+            c->next = chunks;
+            chunks = c;
+            if (!lastChunk) {
+                lastChunk = c;
+            }
+            for (int i = chunkNodes - 1; i >= 0; i--) {
+                c->nodes[i].next = freeList;
+                freeList = &c->nodes[i];
+            }
+            freeTail = &c->nodes[chunkNodes - 1];
+        }
+        Node *n = freeList;
+        freeList = n->next;
+        if (!freeList) {
+            freeTail = nullptr;
+        }
+        n->child = nullptr;
+        n->next = nullptr;
+        n->prev = nullptr;
+        return n;
+    }
 
     /**
-     * @brief Performs a linear search for element e
-     * 
-     * @details Time complexity: O(size)
-     * 
-     * @param e The element to search for
-     * 
-     * @return The index of the element if found, -1 otherwise
+     * @brief Destroys the key of n and puts it on the free list
      */
-    int linearSearch(elmtype e) {
-        for (int i = 0; i < size; i++) {
-            if (atRef(i) == e) return i;
+    void freeNode(Node *n) {
+        std::destroy_at(&n->key);
+        n->next = freeList;
+        if (!freeList) {
+            freeTail = n;
         }
-        return -1;
-    };
+        freeList = n;
+    }
 
     /**
-     * @brief Performs a binary search for element e
-     * 
-     * @details Time complexity: O(lg(size))
-     * 
-     * @param e The element to search for
+     * @brief Forgets the tree and the pool without freeing them
+     */
+    void reset() {
+        root = nullptr;
+        count = 0;
+        chunks = nullptr;
+        lastChunk = nullptr;
+        freeList = nullptr;
+        freeTail = nullptr;
+    }
+
+    /**
+     * @brief Takes over the tree and the pool of src, leaving it empty
+     */
+    void take(PairingHeap &src) {
+        root = src.root;
+        count = src.count;
+        chunks = src.chunks;
+        lastChunk = src.lastChunk;
+        freeList = src.freeList;
+        freeTail = src.freeTail;
+        src.reset();
+    }
+
+    /**
+     * @brief Destroys every key in the tree and frees every chunk
      * 
-     * @return The index of the element if found, -1 otherwise
+     * @details Walks the tree through its child and next links with an explicit stack. Time complexity: O(n)
      */
-    int binSearch(elmtype e) {
-        for (int m = size / 2, l = 0, r = size; l <= r; m = (r + l) / 2) {
-            if (e == atRef(m)) {
-                return m;
-            } else if (e > atRef(m)) {
-                l = m + 1;
-            } else {
-                r = m - 1;
+    void release() {
+        if constexpr (!std::is_trivially_destructible_v<keyType>) {
+            std::vector<Node *> stack;
+            if (root) {
+                stack.push_back(root);
+            }
+            while (!stack.empty()) {
+                Node *n = stack.back();
+                stack.pop_back();
+                if (n->child) {
+                    stack.push_back(n->child);
+                }
+                if (n->next) {
+                    stack.push_back(n->next);
+                }
+                std::destroy_at(&n->key);
             }
         }
-        return -1;
+        while (chunks) {
+            Chunk *c = chunks->next;
+            delete chunks;
+            chunks = c;
+        }
+        reset();
     }
+};
 
-   private:
-    // Array Data
+/**
+ * @brief Whether keys of type T can be stored in a lock-free std::atomic, so threads can read copies of them without a lock
+ */
+template<typename T, bool = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>> struct lockFreeKey : std::false_type {};
 
-    /**
-     * @brief The capacity of the array
-     */
-    int cap;
+template<typename T> struct lockFreeKey<T, true> : std::bool_constant<std::atomic<T>::is_always_lock_free> {};
+
+/**
+ * @brief Implements a relaxed concurrent Minimum Priority Queue (MultiQueue) from locked Heap shards
+ * 
+ * @details Keys are spread over shardsPerThread * threads heaps, each behind its own try-lock on its own cache line. insert locks a
+ *          random shard; tryExtractMin locks two random shards and removes the smaller of their minimums. Threads that find a shard
+ *          locked pick another one instead of waiting, so there is no shared hot spot. The order is relaxed: the removed key is the
+ *          minimum of two shards rather than of the whole queue. Its expected rank among the keys in the queue grows linearly with the
+ *          number of shards, so shardsPerThread is the relaxation parameter: it trades order quality for lower contention. The rank
+ *          error is statistical rather than a hard bound. Measured with benchmarks/multiqueue_bench.cpp on 100K keys, the mean rank
+ *          error is about 0 for 2 shards, 1.4 for 4, 11 for 16, 50 for 64 and 100 for 128, roughly 0.8 per shard.
+ * 
+ * @note Any number of threads may call insert and tryExtractMin concurrently.
+ * 
+ * @tparam keyType The type of key stored in the queue
+ * @tparam Compare The ordering of the keys; the queue favours the smallest keys, so std::greater gives a maximum queue
+ */
+template<typename keyType, typename Compare = std::less<keyType>> class MultiQueue {
 
-    /**
-     * @brief The size of the array
-     */
-    int size;
+    public:
 
     /**
-     * @brief The index of the first element in the array
+     * @brief Constructs an empty queue
+     * 
+     * @param threads The number of threads expected to use the queue
+     * @param shardsPerThread The number of shards per thread; higher values lower contention and loosen the order, see the class
+     *        description for the expected rank error per shard count
+     * @param comp The ordering of the keys
      */
-    int start;
+    MultiQueue(int threads, int shardsPerThread = 2, const Compare &comp = Compare()) : comp(comp) {
+        shards = std::max(2, std::max(threads, 1) * std::max(shardsPerThread, 1));
+        info = new Shard[shards];
+        for (int i = 0; i < shards; i++) {
+            info[i].heap = Heap<keyType, 4, Compare>(comp);
+        }
+    }
+
+    MultiQueue(const MultiQueue &) = delete;
+    MultiQueue &operator=(const MultiQueue &) = delete;
 
     /**
-     * @brief The index of the last element in the array
+     * @brief Destructor. No other thread may be using the queue.
      */
-    int end;
+    ~MultiQueue() {
+        delete[] info;
+    }
 
     /**
-     * @brief The array data, indexed by start and end
+     * @brief Returns the number of keys in the queue
+     * 
+     * @details The value is a snapshot while other threads are inserting or removing keys. Time complexity: O(shards)
      */
-    elmtype *info;
+    int size() {
+        int n = 0;
+        for (int i = 0; i < shards; i++) {
+            n += info[i].count.load(std::memory_order_relaxed);
+        }
+        return n;
+    }
 
     /**
-     * @brief Burner element for error handling
+     * @brief Returns the number of shards
      */
-    elmtype burner;
+    int shardCount() { return shards; }
 
     /**
-     * @brief The type of search to perform in the select function
+     * @brief Inserts a new key into a random shard
      * 
-     * @details standard uses the median as the partition element, worstCase uses the median of medians with subarray size 5
-     *          standard is faster for most cases, worstCase is faster for worst case scenarios
+     * @details Time complexity: O(log(n / shards)) expected, n = size
+     * 
+     * @param k The key to insert
      */
-    enum searchType { standard, worstCase };
+    void insert(keyType k) {
+        for (;;) {
+            Shard &s = info[randomShard()];
+            if (s.tryLock()) {
+                s.heap.insert(std::move(k));
+                s.publish();
+                s.unlock();
+                return;
+            }
+        }
+    }
 
     /**
-     * @brief Used in delFront and delEnd functions to half the capacity of the array if size < cap / 4
+     * @brief Removes a key close to the minimum
      * 
-     * @details Time complexity: O(1) (Amortized)
+     * @details Removes the smaller of the minimums of two random shards. For trivially copyable keys with lock-free atomics the two
+     *          minimums are compared through the copies the shards publish, so only the winning shard is locked; other keys lock both
+     *          shards to compare them. If both are empty, scans every shard from a random one
+     *          and removes the minimum of the first shard that has keys, so false is only returned once every shard was seen empty.
+     *          Time complexity: O(log(n / shards)) expected, O(shards) when the queue is nearly empty
+     * 
+     * @param out Receives the removed key
+     * 
+     * @return True if a key was removed, false if the queue is empty
      */
-    void checkCapDecrease() {
-        if (((cap / 4) - 1) > size) {
-            elmtype *newArr = new elmtype[cap / 2];
-            for (int i = 0; i < size; i++) {
-                newArr[i] = info[start + i];
+    bool tryExtractMin(keyType &out) {
+        int i, j;
+        for (;;) {
+            i = randomShard();
+            j = randomShard();
+            if (i == j) {
+                j = i + 1 == shards ? 0 : i + 1;
             }
-            cap /= 2;
-            start = 0;
-            delete[] info;
-            info = newArr;
-
-            if (size > 0) {
-                end = size - 1;
+            Shard &a = info[i];
+            Shard &b = info[j];
+            if constexpr (cacheTop) {
+                // Compares the published minimums and only locks the shard that wins
+                bool aHas = a.count.load(std::memory_order_relaxed) > 0;
+                bool bHas = b.count.load(std::memory_order_relaxed) > 0;
+                if (!aHas && !bHas) {
+                    break;
+                }
+                Shard &best = !aHas || (bHas && comp(b.top.load(std::memory_order_relaxed), a.top.load(std::memory_order_relaxed))) ? b : a;
+                if (!best.tryLock()) {
+                    continue;
+                }
+                bool found = best.heap.size() > 0;
+                if (found) {
+                    out = best.heap.extractMin();
+                    best.publish();
+                }
+                best.unlock();
+                if (found) {
+                    return true;
+                }
             } else {
-                end = 0;
-            };
+                if (!a.tryLock()) {
+                    continue;
+                }
+                if (!b.tryLock()) {
+                    a.unlock();
+                    continue;
+                }
+                Shard *best = nullptr;
+                if (a.heap.size() > 0 && b.heap.size() > 0) {
+                    best = comp(b.heap.peekKey(), a.heap.peekKey()) ? &b : &a;
+                } else if (a.heap.size() > 0) {
+                    best = &a;
+                } else if (b.heap.size() > 0) {
+                    best = &b;
+                }
+                if (best) {
+                    out = best->heap.extractMin();
+                    best->publish();
+                }
+                b.unlock();
+                a.unlock();
+                if (best) {
+                    return true;
+                }
+                break;
+            }
         }
-        return;
-    };
 
-    /**
-     * @brief Used in addFront and addEnd functions to double the capacity of the array if size == cap
-     * 
-     * @details Time complexity: O(1) (Amortized)
-     */
-    void checkCapIncrease() {
-        if (size == cap) {
-            elmtype *newArr = new elmtype[cap * 2];
-            for (int i = 0; i < size; i++) {
-                newArr[i] = info[(start + i) % cap];
+        for (int step = 0; step < shards; step++) {
+            Shard &s = info[(i + step) % shards];
+            if (s.count.load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            s.lock();
+            bool found = s.heap.size() > 0;
+            if (found) {
+                out = s.heap.extractMin();
+                s.publish();
+            }
+            s.unlock();
+            if (found) {
+                return true;
             }
-            delete[] this->info;
-            info = newArr;
-            cap *= 2;
-            start = 0;
-            end = size - 1;
         }
-        return;
-    };
+        return false;
+    }
+
+    private:
 
     /**
-     * @brief Used by stableSort function to merge subarrays
-     * 
-     * @details Time complexity: O(nlg(n))
-     * 
-     * @param l The left index of the subarray
-     * @param m The middle index of the subarray (used to split the array)
-     * @param r The right index of the subarray
+     * @brief Whether each shard publishes a copy of its minimum that other threads can read without the lock
      */
-    void merge(int l, int m, int r) {
-        int sub1 = m - l + 1, sub2 = r - m;
+    static constexpr bool cacheTop = lockFreeKey<keyType>::value;
 
-        elmtype *linfo = new elmtype[sub1], *rinfo = new elmtype[sub2];
+    /**
+     * @brief Stands in for the published minimum when keys cannot be read atomically
+     */
+    struct NoTop {};
 
-        for (int i = 0; i < sub1; i++) {
-            int tempIndex = (l + i + start) % cap;
-            linfo[i] = info[tempIndex];
+    /**
+     * @brief A heap with its lock, plus its size and (for lock-free keys) its minimum that can be read without the lock, on its own
+     *        cache line
+     */
+    struct alignas(cacheLineSize) Shard {
+        std::atomic<bool> locked = false;
+        std::atomic<int> count = 0;
+        [[no_unique_address]] std::conditional_t<cacheTop, std::atomic<keyType>, NoTop> top;
+        Heap<keyType, 4, Compare> heap;
+
+        bool tryLock() {
+            return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
         }
-        for (int j = 0; j < sub2; j++) {
-            int tempIndex = (m + j + 1 + start) % cap;
-            rinfo[j] = info[tempIndex];
+
+        void lock() {
+            while (!tryLock()) {
+                std::this_thread::yield();
+            }
         }
 
-        int indexL = 0, indexR = 0, indexM = l;
+        void unlock() { locked.store(false, std::memory_order_release); }
 
-        // Primary Merge Loop
-        while (indexL < sub1 && indexR < sub2) {
-            if (linfo[indexL] <= rinfo[indexR]) {
-                info[(indexM + start) % cap] = linfo[indexL];
-                indexL++;
-            } else {
-                info[(indexM + start) % cap] = rinfo[indexR];
-                indexR++;
+        /**
+         * @brief Publishes the size and minimum after a change. Called with the lock held.
+         */
+        void publish() {
+            count.store(heap.size(), std::memory_order_relaxed);
+            if constexpr (cacheTop) {
+                if (heap.size() > 0) {
+                    top.store(heap.peekKey(), std::memory_order_relaxed);
+                }
             }
-            indexM++;
         }
+    };
 
-        // Merge Remaining Lefts
-        while (indexL < sub1) {
-            info[(indexM + start) % cap] = linfo[indexL];
-            indexL++;
-            indexM++;
-        }
+    /**
+     * @brief The number of shards
+     */
+    int shards;
 
-        // Merge Remaining Rights
-        while (indexR < sub2) {
-            info[(indexM + start) % cap] = rinfo[indexR];
-            indexR++;
-            indexM++;
-        }
+    /**
+     * @brief The shards
+     */
+    Shard *info;
 
-        // Clean Up and Return
-        delete[] linfo;
-        delete[] rinfo;
-        return;
-    };
+    /**
+     * @brief The ordering of the keys
+     */
+    [[no_unique_address]] Compare comp;
 
     /**
-     * @brief Used by stableSort function to perform a mergesort on the array
-     * 
-     * @details Time complexity: O(nlg(n))
-     * 
-     * @param l The left index of the subarray
-     * @param r The right index of the subarray
+     * @brief Returns a uniformly random shard index from a per-thread xorshift generator
      */
-    void mergeSort(int l, int r) {
-        if (l >= r) {
-            return;
-        }
+    int randomShard() {
+        thread_local std::uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) * 0x9E3779B97F4A7C15ull | 1;
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return (int)(((state * 0x2545F4914F6CDD1Dull) >> 32) * (std::uint64_t)shards >> 32);
+    }
+};
 
-        int m = l + (r - l) / 2;
-        mergeSort(l, m);
-        mergeSort(m + 1, r);
-        merge(l, m, r);
-    };
+/**
+ * @brief Keeps the K largest keys of a stream in O(K) memory
+ * 
+ * @details The kept keys sit in a Heap of the opposite polarity, so its root is the smallest kept key and acts as the admission
+ *          threshold. Once K keys are kept, a key that does not order after the threshold is rejected with one comparison against a
+ *          cached copy of it; an accepted key replaces the root with a single sift. Trackers filled on different threads can be
+ *          combined with mergeFrom once those threads are done with them.
+ * 
+ * @tparam keyType The type of key tracked
+ * @tparam Compare The ordering of the keys; the tracker keeps the keys that order last, so std::greater keeps the K smallest
+ */
+template<typename keyType, typename Compare = std::less<keyType>> class TopKTracker {
+
+    public:
 
     /**
-     * @brief Used by QuickSelect and WCSelect to recursively search for the Kth smallest element
-     * 
-     * @details Time complexity: O(n)
+     * @brief Constructs an empty tracker that keeps up to k keys
      * 
-     * @param k The index of the element to find
-     * @param type The type of search to perform
-     * 
-     * @return The Kth smallest element of the array
+     * @param k The number of keys to keep, at least 1
+     * @param comp The ordering of the keys
      */
-    elmtype select(int k, searchType type) {
+    explicit TopKTracker(int k, const Compare &comp = Compare()) : k(std::max(k, 1)), heap(comp), comp(comp) {}
 
-        elmtype tempArr[size];
-        for (int i = 0; i < size; i++) {
-            tempArr[i] = atRef(i);
-        }
+    /**
+     * @brief Returns the number of keys kept
+     */
+    int size() {
+        return heap.size();
+    }
 
-        // Selects the correct function based on the type
-        if (type == standard) {
-            return KthSmallest(tempArr, 0, size - 1, k);
-        }
-        return KthSmallestWC(tempArr, 0, size - 1, k);
+    /**
+     * @brief Returns the maximum number of keys kept
+     */
+    int capacity() {
+        return k;
     }
 
     /**
-     * @brief Recursively finds the Kth smallest element of the array
+     * @brief Returns the smallest kept key, which a new key has to order after once the tracker is full
      * 
-     * @details Time complexity: O(n)
+     * @details Returns a default constructed key if the tracker is empty. Time complexity: O(1)
+     */
+    keyType threshold() {
+        return heap.size() > 0 ? cutoff : keyType();
+    }
+
+    /**
+     * @brief Offers a key to the tracker
      * 
-     * @param arr The array to search
-     * @param l The left index of the subarray
-     * @param r The right index of the subarray
-     * @param k The index of the element to find
+     * @details Time complexity: O(1) for a rejected key, O(log(K)) for an accepted one
      * 
-     * @return The Kth smallest element of the array
+     * @param v The key
+     * 
+     * @return True if the key is now kept, false if it was rejected
      */
-    elmtype KthSmallest(elmtype *arr, int l, int r, int k) {
-        elmtype pivot = arr[(l + r) / 2];
-        int pos = partition(arr, l, r, pivot);
-
-        if (pos - l == k - 1) {
-            return arr[pos];
-        } else if (pos - l > k - 1) {
-            return KthSmallest(arr, l, pos - 1, k);
+    bool push(const keyType &v) {
+        if (heap.size() == k) {
+            if (!comp(cutoff, v)) {
+                return false;
+            }
+            heap.replaceMin(v);
         } else {
-            return KthSmallest(arr, pos + 1, r, k - pos + l - 1);
+            heap.insert(v);
         }
+        cutoff = heap.peekKey();
+        return true;
     }
 
     /**
-     * @brief Gets the Kth smallest element of the subarray. Only used on WCSelect
-     * 
-     * @details Time complexity: O(n)
+     * @brief Offers every key kept by other to this tracker
      * 
-     * @param arr The array to search
-     * @param l The left index of the subarray
-     * @param r The right index of the subarray
-     * @param k The index of the element to find
+     * @details other is left unchanged. Neither tracker may be in use by another thread. Time complexity: O(m * log(K)), m = other.size()
      * 
-     * @return The Kth smallest element of the array
+     * @param other The tracker to merge from
      */
-    elmtype KthSmallestWC(elmtype *arr, int l, int r, int k) {
-        int n = r - l + 1, i;
-        elmtype median[(n + 4) / 5];
-        for (i = 0; i < n / 5; i++) {
-            median[i] = getMedian(arr + l + i * 5, 5);
-        }
-        if (n > i * 5) {
-            median[i] = getMedian(arr + l + i * 5, n % 5);
-            i++;
+    void mergeFrom(const TopKTracker &other) {
+        if (this == &other) {
+            return;
         }
-        elmtype medOfMed =
-            (i == 1) ? median[i - 1] : KthSmallestWC(median, 0, i - 1, i / 2);
-        int pos = partition(arr, l, r, medOfMed);
-
-        if (pos - l == k - 1) {
-            return arr[pos];
-        } else if (pos - l > k - 1) {
-            return KthSmallestWC(arr, l, pos - 1, k);
-        } else {
-            return KthSmallestWC(arr, pos + 1, r, k - pos + l - 1);
+        Heap<keyType, 4, Compare> rest = other.heap;
+        while (rest.size() > 0) {
+            push(rest.extractMin());
         }
     }
 
     /**
-     * @brief Gets the median of the subarray. Only used on WCSelect subarrays due to inefficiency
+     * @brief Returns the kept keys, largest first, without changing the tracker
      * 
-     * @details Time complexity: O(n^2)
+     * @details Time complexity: O(K * log(K))
      */
-    elmtype getMedian(elmtype *arr, int n) {
-        sort(arr, n);
-        return arr[n / 2];
+    std::vector<keyType> sorted() {
+        Heap<keyType, 4, Compare> copy = heap;
+        std::vector<keyType> result = copy.extractMinBatch(copy.size());
+        std::reverse(result.begin(), result.end());
+        return result;
     }
 
     /**
-     * @brief Partitions the subarray
-     * 
-     * @details Time complexity: O(r - l)
-     * 
-     * @param arr The array to partition
-     * @param l The left index of the subarray
-     * @param r The right index of the subarray
-     * @param pivot The pivot element
-     * 
-     * @return The index of the pivot element
+     * @brief Removes every kept key, for example at the start of a new reporting window
      */
-    int partition(elmtype arr[], int l, int r, elmtype pivot) {
-        int i;
-        for (i = l; i < r; i++) {
-            if (arr[i] == pivot) {
-                break;
-            }
-        }
-        swap(&arr[i], &arr[r]);
-        i = l;
-        for (int j = l; j <= r - 1; j++) {
-            if (arr[j] <= pivot) {
-                swap(&arr[i], &arr[j]);
-                i++;
-            }
-        }
-        swap(&arr[i], &arr[r]);
-        return i;
+    void clear() {
+        heap = Heap<keyType, 4, Compare>(comp);
     }
 
+    private:
+
     /**
-     * @brief Sorts a subarray. Only used on WCSelect subarrays due to inefficiency
-     * 
-     * @details Time complexity: O(n^2)
+     * @brief The maximum number of keys kept
      */
-    void sort(elmtype *arr, int n) {
-        for (int i = 0; i < n; i++) {
-            elmtype *smallest = &arr[0];
-            for (int j = i + 1; j < n; j++) {
-                if (arr[j] < (*smallest)) {
-                    smallest = &arr[j];
-                }
-            }
-            if (&arr[i] != smallest) {
-                swap(&arr[i], smallest);
-            }
-        }
-    }
+    int k;
+
+    /**
+     * @brief The kept keys, smallest first
+     */
+    Heap<keyType, 4, Compare> heap;
+
+    /**
+     * @brief A copy of the root of heap, so rejecting a key does not go through the heap
+     */
+    keyType cutoff = keyType();
+
+    /**
+     * @brief The ordering of the keys
+     */
+    [[no_unique_address]] Compare comp;
 };
 
 /**
- * @brief Implements a Minimum Heap
+ * @brief Implements a Radix Heap: a minimum heap for unsigned integer keys that are extracted in nondecreasing order
  * 
- * @tparam keyType The type of key stored in the heap
+ * @details Keys are kept in one bucket per bit position, relative to the last extracted key: bucket 0 holds keys equal to it and bucket
+ *          i holds keys whose highest bit that differs from it is bit i - 1. When bucket 0 runs out, the lowest non-empty bucket (found
+ *          with a bitmask) is emptied into the lower buckets relative to its own minimum. A key only ever moves to a lower bucket, so
+ *          it is moved at most once per bit and no comparisons between keys are needed beyond finding a bucket's minimum.
+ *          The monotone precondition: a key may not be smaller than the last extracted key; insert rejects such keys.
+ * 
+ * @tparam keyType The unsigned integer type of the keys
  */
-template<typename keyType> class Heap {
+template<typename keyType = std::uint32_t> class RadixHeap {
+
+    static_assert(std::is_unsigned_v<keyType> && !std::is_same_v<keyType, bool>, "RadixHeap requires an unsigned integer key type");
 
     public:
 
     /**
      * @brief Default Constructor
+     * 
+     * @details Buckets are emptied and refilled all the time, so they keep their capacity instead of shrinking
      */
-    Heap() { info = new CircularDynamicArray<keyType>; }
-
-    /**
-     * @brief Constructs a heap with keys K and size s
-     */
-    Heap(keyType K[], int s) {
-        info = new CircularDynamicArray<keyType>(s);
-        
-        for (int i = 0; i < s; i++) {
-            (*info)[i] = K[i];
+    RadixHeap() {
+        for (Bucket &b : buckets) {
+            b.setShrinkThreshold(0);
         }
-
-        heapify();
     }
 
     /**
-     * @brief Destructor
+     * @brief Returns the size of the heap
      */
-    ~Heap() {
-        // The CDA is deleted in its cleanup, deleting here will segfault
+    int size() {
+        return count;
     }
 
     /**
-     * @brief Returns the size of the heap
+     * @brief Returns the last extracted key, which every inserted key has to be at least; 0 before the first extraction
      */
-    int size() {
-        return info->length();
+    keyType lastKey() {
+        return last;
     }
 
     /**
      * @brief Returns the minimum key in the heap
      * 
-     * @details Time complexity: O(1)
+     * @details Returns 0 if the heap is empty. May redistribute a bucket, like extractMin. Time complexity: O(log(C)) amortized,
+     *          C = the largest key
      * 
      * @return The minimum key
      */
     keyType peekKey() {
-        return (*info)[0];
+        if (count == 0) {
+            return keyType();
+        }
+        refill();
+        return last;
     }
 
     /**
-     * @brief Inserts a new node with key k
+     * @brief Inserts a new key
      * 
-     * @details Time complexity: O(lg(n)), n = size
+     * @details Time complexity: O(1)
      * 
      * @param k The key to insert
-     */
-    void insert(keyType k) {
-        info->addEnd(k);
-        siftUp(info->length() - 1);
-    }
-
-    /**
-     * @brief Prints all keys in the heap in level order
      * 
-     * @param out The output stream to print to, defaulting to std::cout
+     * @return True if the key was inserted, false if it is smaller than the last extracted key
      */
-    void printKeys(std::ostream &out = std::cout) {
-        for (int i = 0; i < info->length(); i++) {
-            out << (*info)[i];
-            if (i != info->length() - 1) {
-                out << " ";
-            }
+    bool insert(keyType k) {
+        if (k < last) {
+            return false;
         }
-        if (info->length() != 0) {out << std::endl;}
+        int b = bucketOf(k);
+        buckets[b].addEnd(k);
+        if (b > 0) {
+            nonEmpty |= std::uint64_t(1) << (b - 1);
+        }
+        count++;
+        return true;
     }
 
     /**
-     * @brief Removes the minimum key from the heap and restores heap priority
+     * @brief Removes the minimum key from the heap
      * 
-     * @details Time complexity: O(lg(n)), n = size
+     * @details Returns 0 if the heap is empty. Time complexity: O(log(C)) amortized, C = the largest key
      * 
-     * @return The minimum key
+     * @return The minimum key, which becomes the last extracted key
      */
     keyType extractMin() {
-        keyType min = (*info)[0];
-        (*info)[0] = (*info)[info->length() - 1];
-        info->delEnd();
-        siftDown(0);
-        return min;
+        if (count == 0) {
+            return keyType();
+        }
+        refill();
+        buckets[0].delEnd();
+        count--;
+        return last;
     }
 
     private:
-    
+
     /**
-     * @brief The array that stores the heap
+     * @brief The number of bits in a key, and the index of the highest bucket
      */
-    CircularDynamicArray<keyType> *info;
+    static constexpr int bits = std::numeric_limits<keyType>::digits;
 
     /**
-     * @brief Turns the array into a minHeap by repeatedly performing siftDown
-     * 
-     * @details Time complexity: O(n)
+     * @brief A bucket of keys; the power-of-two capacity wraps positions with a mask instead of a division
      */
-    void heapify() {
-        for (int i = info->length() / 2; i >= 0; i--) {
-            siftDown(i);
-        }
-    }
+    using Bucket = CircularDynamicArray<keyType, PowerOfTwoCapacity>;
 
     /**
-     * @brief Sifts the node at index i down in the heap
-     * 
-     * @details Time complexity: O(lg(n))
-     * 
-     * @param i The index of the node to sift down
+     * @brief The buckets; buckets[0] holds keys equal to last
      */
-    void siftDown(int i) {
-        int l = lIndex(i), r = rIndex(i), min = i;
-
-        if (l < info->length() && (*info)[l] < (*info)[i]) { min = l; }
-        if (r < info->length() && (*info)[r] < (*info)[min]) { min = r; }
-        if (min != i) { swap(i, min); siftDown(min); }
-    }
+    Bucket buckets[bits + 1];
 
     /**
-     * @brief Sifts the node at index i up in the heap
-     * 
-     * @details Time complexity: O(lg(n))
-     * 
-     * @param i The index of the node to sift up
+     * @brief Bit i - 1 is set if buckets[i] is not empty
      */
-    void siftUp(int i) {
-        for (; i != 0 && (*info)[i] < (*info)[pIndex(i)]; i = pIndex(i)) {
-            swap(i, pIndex(i));
-        }
-    }
+    std::uint64_t nonEmpty = 0;
 
     /**
-     * @brief Swaps two elements in the heap
-     * 
-     * @details Time complexity: O(1)
-     * 
-     * @param a The index of the first element
-     * @param b The index of the second element
+     * @brief The last extracted key, or the minimum once refill has run
      */
-    void swap(int a, int b) {
-        keyType temp = (*info)[a];
-        (*info)[a] = (*info)[b];
-        (*info)[b] = temp;
-    }
+    keyType last = 0;
 
     /**
-     * @brief Returns the index of the parent of the node at index i
-     * 
-     * @details Time complexity: O(1)
-     * 
-     * @param i The index of the node
-     * 
-     * @return The index of the parent
+     * @brief The number of keys in the heap
      */
-    int pIndex(int i) {
-        return (i-1) / 2;
-    }
+    int count = 0;
 
     /**
-     * @brief Returns the index of the left child of the node at index i
-     * 
-     * @details Time complexity: O(1)
-     * 
-     * @param i The index of the node
-     * 
-     * @return The index of the left child
+     * @brief Returns the bucket of key k relative to last
      */
-    int lIndex(int i) {
-        return (i*2) + 1;
+    int bucketOf(keyType k) {
+        return k == last ? 0 : (int)std::bit_width((keyType)(k ^ last));
     }
 
     /**
-     * @brief Returns the index of the right child of the node at index i
-     * 
-     * @details Time complexity: O(1)
-     * 
-     * @param i The index of the node
+     * @brief Makes sure bucket 0 holds the minimum by emptying the lowest non-empty bucket into the buckets below it
      * 
-     * @return The index of the right child
+     * @details Only called when the heap is not empty. Time complexity: O(s), s = size of the emptied bucket
      */
-    int rIndex(int i) {
-        return (i*2) + 2;
+    void refill() {
+        if (buckets[0].length() > 0) {
+            return;
+        }
+        int i = std::countr_zero(nonEmpty) + 1;
+        Bucket &from = buckets[i];
+        auto [first, second] = from.segments();
+        keyType min = first[0];
+        for (keyType k : first) {
+            min = std::min(min, k);
+        }
+        for (keyType k : second) {
+            min = std::min(min, k);
+        }
+        last = min;
+        for (std::span<keyType> part : {first, second}) {
+            for (keyType k : part) {
+                int b = bucketOf(k);
+                buckets[b].addEnd(k);
+                if (b > 0) {
+                    nonEmpty |= std::uint64_t(1) << (b - 1);
+                }
+            }
+        }
+        from.delEnd(from.length());
+        nonEmpty &= ~(std::uint64_t(1) << (i - 1));
     }
 };
 
@@ -1162,6 +5771,10 @@ template<typename keyType, typename valueType> class RBNode {
  * 
  * These properties ensure that the tree remains approximately balanced, 
  * making it suitable for applications requiring fast lookups, insertions, and deletions.
+ * 
+ * @bug remove can dereference a null parent pointer in deleteFixTree and crash. Inserting the keys i * 7919 % 400 for i < 100 and
+ *      then removing them in the same order is enough to trigger it. Until this is fixed, workloads that remove many keys should
+ *      use another structure; the MultiQueue benchmark uses a Fenwick tree for this reason.
  */
 template<typename keyType, typename valueType> class RBTree {
     public:
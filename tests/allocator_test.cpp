@@ -0,0 +1,152 @@
+#include "../datastructs.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+
+int main() {
+    // Bump allocation, alignment and giving back the most recent allocation
+    {
+        MonotonicArena arena(1024);
+        char *a = (char *)arena.allocate(3, 1);
+        double *b = (double *)arena.allocate(sizeof(double), alignof(double));
+        assert((std::uintptr_t)b % alignof(double) == 0);
+        assert((char *)b > a);
+        arena.deallocate(b, sizeof(double));
+        assert(arena.allocate(sizeof(double), alignof(double)) == b);
+        arena.deallocate(a, 3); // Not the most recent, ignored
+        assert((char *)arena.allocate(1, 1) == (char *)b + sizeof(double));
+
+        // Larger than a chunk
+        char *big = (char *)arena.allocate(10000, 64);
+        assert((std::uintptr_t)big % 64 == 0);
+        big[0] = big[9999] = 1;
+
+        arena.reset();
+        char *again = (char *)arena.allocate(10000, 64);
+        assert(again == big);
+    }
+
+    // Caller supplied buffer is used first
+    {
+        alignas(16) char buffer[256];
+        MonotonicArena arena(buffer, sizeof(buffer));
+        char *p = (char *)arena.allocate(100, 16);
+        assert(p == buffer);
+        char *q = (char *)arena.allocate(200, 16);
+        assert(q < buffer || q >= buffer + sizeof(buffer));
+        arena.reset();
+        assert((char *)arena.allocate(8, 8) != nullptr);
+    }
+
+    // Alignment padding near the end of the buffer moves on to a chunk instead of past the end
+    {
+        alignas(16) char buffer[100];
+        MonotonicArena arena(buffer, sizeof(buffer));
+        char *p = (char *)arena.allocate(99, 1);
+        assert(p == buffer);
+        char *q = (char *)arena.allocate(8, 8);
+        assert(q < buffer || q >= buffer + sizeof(buffer));
+        assert((std::uintptr_t)q % 8 == 0);
+        std::memset(q, 1, 8);
+        char *r = (char *)arena.allocate(1, 1);
+        assert(r == q + 8);
+    }
+
+    // The same 3 bytes short of the end of a 260 byte heap chunk
+    {
+        MonotonicArena arena(260);
+        char *p = (char *)arena.allocate(257, 1);
+        char *q = (char *)arena.allocate(16, 16);
+        assert((std::uintptr_t)q % 16 == 0 && (q < p || q >= p + 260));
+        q[0] = q[15] = 1;
+    }
+
+    // Circular dynamic arrays in an arena
+    {
+        MonotonicArena arena;
+        ArenaAllocator<int> alloc(arena);
+        CircularDynamicArray<int, ModuloCapacity, ArenaAllocator<int>> cda(alloc);
+        for (int i = 0; i < 1000; i++) {
+            if (i % 2) {
+                cda.addEnd(i);
+            } else {
+                cda.addFront(i);
+            }
+        }
+        assert(cda.length() == 1000);
+        assert(cda[0] == 998 && cda[999] == 999);
+        assert(cda.get_allocator() == alloc);
+
+        cda.stableSort();
+        for (int i = 0; i < 1000; i++) {
+            assert(cda[i] == i);
+        }
+        assert(cda.QuickSelect(10) == 9);
+
+        CircularDynamicArray<int, ModuloCapacity, ArenaAllocator<int>> copy(cda);
+        assert(copy.length() == 1000 && copy[500] == 500);
+
+        CircularDynamicArray<int, ModuloCapacity, ArenaAllocator<int>> sized(10, alloc);
+        assert(sized.length() == 10 && sized[9] == 0);
+
+        using StringArray = CircularDynamicArray<std::string, PowerOfTwoCapacity, ArenaAllocator<std::string>>;
+        StringArray words{ArenaAllocator<std::string>(arena)};
+        for (int i = 0; i < 100; i++) {
+            words.addEnd(std::string(30, (char)('a' + i % 26)));
+        }
+        for (int i = 0; i < 90; i++) {
+            words.delFront();
+        }
+        assert(words.length() == 10 && words[0] == std::string(30, 'm'));
+
+        // Moving between arrays on different arenas moves the elements, not the storage
+        MonotonicArena other;
+        StringArray moved{ArenaAllocator<std::string>(other)};
+        moved.addEnd("x");
+        moved = std::move(words);
+        assert(moved.length() == 10 && moved[9] == std::string(30, 'v'));
+        assert(moved.get_allocator().arena == &other);
+
+        // Same arena, the storage is swapped
+        StringArray swapped{ArenaAllocator<std::string>(other)};
+        swapped = std::move(moved);
+        assert(swapped.length() == 10 && swapped[0] == std::string(30, 'm'));
+    }
+
+    // Huge page backed storage, large enough to be mapped
+    {
+        CircularDynamicArray<int, PowerOfTwoCapacity, HugePageAllocator<int>> large;
+        for (int i = 0; i < (1 << 20); i++) {
+            large.addEnd(i);
+        }
+        assert(large.length() == (1 << 20));
+        assert(large[123456] == 123456);
+        for (int i = 0; i < (1 << 20) - 10; i++) {
+            large.delEnd();
+        }
+        assert(large.length() == 10 && large[9] == 9);
+
+        HugePageAllocator<double> dalloc;
+        double *p = dalloc.allocate(1 << 20);
+        assert((std::uintptr_t)p % 64 == 0);
+        p[0] = p[(1 << 20) - 1] = 1.0;
+        dalloc.deallocate(p, 1 << 20);
+    }
+
+    // std::pmr
+    {
+        std::pmr::monotonic_buffer_resource resource;
+        CircularDynamicArray<long, ModuloCapacity, std::pmr::polymorphic_allocator<long>> pcda{std::pmr::polymorphic_allocator<long>(&resource)};
+        for (long i = 0; i < 100; i++) {
+            pcda.addFront(i);
+        }
+        assert(pcda[0] == 99 && pcda.get_allocator().resource() == &resource);
+        pcda.radixSort();
+        assert(pcda[0] == 0 && pcda[99] == 99);
+    }
+
+    return 0;
+}
@@ -1,6 +1,45 @@
 #include "../datastructs.hpp"
 
 #include <cassert>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Counts live objects and default constructions to check that storage is only constructed on demand
+struct Tracked {
+    static int live, defaults;
+    int v;
+    Tracked() : v(0) { live++; defaults++; }
+    Tracked(int x) : v(x) { live++; }
+    Tracked(const Tracked &o) : v(o.v) { live++; }
+    Tracked(Tracked &&o) : v(o.v) { o.v = -1; live++; }
+    Tracked &operator=(const Tracked &o) = default;
+    Tracked &operator=(Tracked &&o) = default;
+    ~Tracked() { live--; }
+};
+int Tracked::live = 0, Tracked::defaults = 0;
+
+// Counts the calls that reach the allocator
+int allocations = 0, deallocations = 0;
+template <typename T> struct CountingAllocator {
+    using value_type = T;
+    CountingAllocator() = default;
+    template <typename U> CountingAllocator(const CountingAllocator<U> &) {}
+    T *allocate(std::size_t n) {
+        allocations++;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T *p, std::size_t n) {
+        deallocations++;
+        std::allocator<T>().deallocate(p, n);
+    }
+    template <typename U> bool operator==(const CountingAllocator<U> &) const { return true; }
+};
 
 int main() {
     CircularDynamicArray<int> cda(25);
@@ -85,5 +124,582 @@ int main() {
     cda2.addEnd(1005);
     assert(cda[24] != cda2[24]);
 
+    // Power-of-two capacity policy
+    CircularDynamicArray<int, PowerOfTwoCapacity> pcda(25);
+    assert(pcda.capacity() == 32);
+    static_assert(PowerOfTwoCapacity::fit(0) == 1 && PowerOfTwoCapacity::fit(33) == 64);
+    static_assert(PowerOfTwoCapacity::fit(PowerOfTwoCapacity::maxCapacity) == 1 << 30);
+    bool tooLarge = false;
+    try {
+        pcda.reserve(PowerOfTwoCapacity::maxCapacity + 1);
+    } catch (const std::length_error &) {
+        tooLarge = true;
+    }
+    assert(tooLarge && pcda.capacity() == 32);
+
+    for (int i = 0; i < 25; i++) {
+        pcda[i] = i*10;
+    }
+
+    // Wrap the start and end indices around the buffer
+    for (int i = 0; i < 20; i++) {
+        pcda.delFront();
+        pcda.addEnd(1000 + i);
+    }
+    assert(pcda.length() == 25);
+    assert(pcda[0] == 200);
+    assert(pcda[24] == 1019);
+
+    for (int i = 0; i < 10; i++) {
+        pcda.addFront(-i);
+    }
+    assert(pcda.capacity() == 64);
+    assert(pcda[0] == -9);
+    assert(pcda[10] == 200);
+    assert(pcda[34] == 1019);
+
+    for (int i = 0; i < 30; i++) {
+        pcda.delEnd();
+    }
+    assert(pcda.length() == 5);
+    assert(pcda.capacity() == 16);
+    assert(pcda[0] == -9 && pcda[4] == -5);
+
+    pcda.stableSort();
+    assert(pcda[0] == -9 && pcda[4] == -5);
+    assert(pcda.QuickSelect(2) == -8);
+    assert(pcda.WCSelect(5) == -5);
+    assert(pcda.binSearch(-7) == 2);
+
+    // Uninitialized storage, emplace and move support
+    {
+        // Each array holds one default constructed burner element
+        CircularDynamicArray<Tracked> tcda;
+        assert(Tracked::live == 1 && Tracked::defaults == 1);
+        for (int i = 0; i < 100; i++) {
+            if (i % 2) {
+                tcda.emplaceEnd(i);
+            } else {
+                tcda.emplaceFront(i);
+            }
+        }
+        assert(Tracked::live == 101);
+        for (int i = 0; i < 90; i++) {
+            tcda.delFront();
+        }
+        assert(Tracked::live == 11);
+        CircularDynamicArray<Tracked> tcda2 = tcda;
+        assert(Tracked::live == 22);
+        tcda2.clear();
+        assert(Tracked::live == 12);
+    }
+    assert(Tracked::live == 0);
+    assert(Tracked::defaults == 2);
+
+    CircularDynamicArray<std::string> scda;
+    std::string moved = "moved string";
+    scda.addEnd(std::move(moved));
+    scda.emplaceFront(3, 'x');
+    scda.addEnd(scda[0]); // Grows while copying one of its own elements
+    assert(scda.length() == 3 && scda.capacity() == 4);
+    assert(scda[0] == "xxx" && scda[1] == "moved string" && scda[2] == "xxx");
+
+    // An array constructed with size 0 still has storage
+    CircularDynamicArray<int> zcda(0);
+    assert(zcda.length() == 0 && zcda.capacity() >= 1);
+    zcda.addEnd(2);
+    zcda.addFront(1);
+    zcda.addEnd(3);
+    assert(zcda.length() == 3 && zcda[0] == 1 && zcda[2] == 3);
+    CircularDynamicArray<std::string> zscda(0);
+    zscda.addFront("a");
+    zscda.delEnd();
+    zscda.addEnd("b");
+    assert(zscda.length() == 1 && zscda[0] == "b");
+
+    // End operations after a front insertion into an empty array
+    CircularDynamicArray<std::string> frontStr;
+    frontStr.addFront("front");
+    frontStr.delEnd();
+    assert(frontStr.length() == 0);
+    CircularDynamicArray<int> ficda;
+    ficda.addFront(1);
+    ficda.delEnd();
+    ficda.addEnd(5);
+    ficda.addFront(4);
+    assert(ficda.length() == 2 && ficda[0] == 4 && ficda[1] == 5);
+    ficda.clear();
+    ficda.emplaceFront(7);
+    ficda.addEnd(8);
+    assert(ficda[0] == 7 && ficda[1] == 8);
+
+    CircularDynamicArray<std::string> scda2 = std::move(scda);
+    assert(scda2.length() == 3 && scda.length() == 0);
+    scda.addEnd("reused");
+    assert(scda[0] == "reused");
+
+    // Bulk range append and prepend
+    CircularDynamicArray<int> rcda;
+    rcda.addEnd(1);
+    rcda.addFront(0);
+    std::vector<int> tail(100);
+    for (int i = 0; i < 100; i++) {
+        tail[i] = i + 2;
+    }
+    rcda.appendRange(tail);
+    assert(rcda.length() == 102 && rcda.capacity() == 128);
+    for (int i = 0; i < 102; i++) {
+        assert(rcda[i] == i);
+    }
+
+    int head[30];
+    for (int i = 0; i < 30; i++) {
+        head[i] = i - 30;
+    }
+    rcda.prependRange(head); // Wraps around the physical end of the buffer
+    assert(rcda.length() == 132 && rcda.capacity() == 256);
+    for (int i = 0; i < 132; i++) {
+        assert(rcda[i] == i - 30);
+    }
+
+    // End operations after prepending into an empty array
+    CircularDynamicArray<int> prcda;
+    prcda.prependRange(std::span<const int>(head, 3));
+    prcda.delEnd();
+    prcda.addEnd(7);
+    prcda.appendRange(std::span<const int>(head + 3, 2));
+    assert(prcda.length() == 5 && prcda[0] == -30 && prcda[1] == -29 && prcda[2] == 7 && prcda[4] == -26);
+    CircularDynamicArray<std::string> prscda;
+    std::vector<std::string> prefix = {"a", "b"};
+    prscda.prependRange(prefix.begin(), prefix.end());
+    prscda.delEnd();
+    prscda.delEnd();
+    assert(prscda.length() == 0);
+
+    CircularDynamicArray<std::string, PowerOfTwoCapacity> srcda;
+    std::list<std::string> words = {"b", "c"};
+    srcda.appendRange(words.begin(), words.end());
+    srcda.prependRange(words.begin(), words.end());
+    std::istringstream wordStream("x y");
+    srcda.appendRange(std::istream_iterator<std::string>(wordStream), std::istream_iterator<std::string>());
+    assert(srcda.length() == 6 && srcda.capacity() == 8);
+    assert(srcda[0] == "b" && srcda[1] == "c" && srcda[2] == "b" && srcda[3] == "c" && srcda[4] == "x" && srcda[5] == "y");
+
+    // Segment views and iterators
+    static_assert(std::random_access_iterator<CircularDynamicArray<int>::iterator>);
+    static_assert(std::random_access_iterator<CircularDynamicArray<int>::const_iterator>);
+
+    CircularDynamicArray<int, PowerOfTwoCapacity> vcda;
+    for (int i = 0; i < 8; i++) {
+        vcda.addEnd(i);
+    }
+    for (int i = 0; i < 5; i++) {
+        vcda.delFront();
+        vcda.addEnd(8 + i);
+    }
+    // vcda = {5, 6, ... , 12}, physically wrapped after 7
+    auto [front, back] = vcda.segments();
+    assert(front.size() == 3 && back.size() == 5);
+    assert(front[0] == 5 && front[2] == 7 && back[0] == 8 && back[4] == 12);
+    assert(std::accumulate(vcda.begin(), vcda.end(), 0) == 68);
+    assert(vcda.end() - vcda.begin() == 8 && vcda.begin()[3] == 8);
+
+    std::sort(vcda.begin(), vcda.end(), [](int a, int b) { return a > b; });
+    for (int i = 0; i < 8; i++) {
+        assert(vcda[i] == 12 - i);
+    }
+
+    const CircularDynamicArray<int, PowerOfTwoCapacity> &cvcda = vcda;
+    CircularDynamicArray<int, PowerOfTwoCapacity>::const_iterator found = std::find(cvcda.begin(), cvcda.end(), 8);
+    assert(found - vcda.begin() == 4);
+    assert(cvcda.segments().first.size() + cvcda.segments().second.size() == 8);
+
+    CircularDynamicArray<int> ecda;
+    assert(ecda.begin() == ecda.end() && ecda.segments().first.empty() && ecda.segments().second.empty());
+
+    // Parallel stable sort on a wrapped array, ties must keep their insertion order
+    struct Keyed {
+        int key, order;
+        bool operator<(const Keyed &o) const { return key < o.key; }
+    };
+    CircularDynamicArray<Keyed> kcda;
+    unsigned seed = 12345;
+    for (int i = 0; i < 100000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        kcda.addEnd({(int)(seed >> 16) % 1000, i});
+    }
+    for (int i = 0; i < 30000; i++) {
+        kcda.delFront();
+        seed = seed * 1103515245u + 12345u;
+        kcda.addEnd({(int)(seed >> 16) % 1000, 100000 + i});
+    }
+    kcda.stableSort(4);
+    for (int i = 1; i < kcda.length(); i++) {
+        assert(kcda[i - 1].key < kcda[i].key || (kcda[i - 1].key == kcda[i].key && kcda[i - 1].order < kcda[i].order));
+    }
+
+    CircularDynamicArray<std::string> sscda;
+    for (int i = 0; i < 500; i++) {
+        sscda.addFront(std::to_string(i * 7919 % 500));
+    }
+    sscda.stableSort(1);
+    for (int i = 1; i < sscda.length(); i++) {
+        assert(!(sscda[i] < sscda[i - 1]));
+    }
+
+    // LSD radix sort for arithmetic elements
+    CircularDynamicArray<int> icda;
+    for (int i = 0; i < 5000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        icda.addFront((int)seed);
+    }
+    icda.addEnd(std::numeric_limits<int>::min());
+    icda.addEnd(std::numeric_limits<int>::max());
+    icda.addEnd(0);
+    CircularDynamicArray<int> icda2 = icda;
+    icda.radixSort();
+    icda2.stableSort();
+    for (int i = 0; i < icda.length(); i++) {
+        assert(icda[i] == icda2[i]);
+    }
+    assert(icda[0] == std::numeric_limits<int>::min());
+
+    CircularDynamicArray<std::uint64_t, PowerOfTwoCapacity> ucda;
+    for (int i = 0; i < 3000; i++) {
+        ucda.addEnd((std::uint64_t)(i % 7) << 40); // Most digits are constant and skipped
+    }
+    ucda.radixSort();
+    for (int i = 1; i < ucda.length(); i++) {
+        assert(ucda[i - 1] <= ucda[i]);
+    }
+    assert(ucda[2999] == (std::uint64_t)6 << 40);
+
+    CircularDynamicArray<double> dcda;
+    double doubles[] = {3.5, -0.25, 1e300, -1e300, 0.0, -7.0, std::numeric_limits<double>::infinity(), 2.0, -std::numeric_limits<double>::infinity()};
+    dcda.appendRange(doubles);
+    dcda.radixSort();
+    double sortedDoubles[] = {-std::numeric_limits<double>::infinity(), -1e300, -7.0, -0.25, 0.0, 2.0, 3.5, 1e300, std::numeric_limits<double>::infinity()};
+    for (int i = 0; i < 9; i++) {
+        assert(dcda[i] == sortedDoubles[i]);
+    }
+
+    CircularDynamicArray<short> shcda;
+    for (int i = 0; i < 1000; i++) {
+        shcda.addEnd((short)(500 - i));
+    }
+    shcda.radixSort();
+    assert(shcda[0] == -499 && shcda[999] == 500);
+
+    // Introselect on copies and in place, with duplicates and adversarial orders
+    CircularDynamicArray<int> qcda;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        qcda.addEnd((int)(seed >> 16) % 300);
+    }
+    CircularDynamicArray<int> qsorted = qcda;
+    qsorted.stableSort();
+    for (int k = 1; k <= 2000; k += 37) {
+        assert(qcda.QuickSelect(k) == qsorted[k - 1]);
+        assert(qcda.WCSelect(k) == qsorted[k - 1]);
+    }
+    assert(qcda.QuickSelect(2000) == qsorted[1999]);
+    assert(qcda.QuickSelect(0) == qcda.QuickSelect(2001)); // Both invalid, return the burner element
+
+    CircularDynamicArray<int> organ;
+    for (int i = 0; i < 100000; i++) {
+        organ.addEnd(i < 50000 ? i : 100000 - i);
+    }
+    assert(organ.QuickSelect(50000) == 25000);
+    assert(organ.WCSelect(1) == 0);
+    assert(organ.QuickSelect(99999, true) == 49999);
+    assert(organ.length() == 100000 && organ[99999] == 50000); // Partitioned in place around index 99998
+
+    CircularDynamicArray<std::string> sselect;
+    for (int i = 0; i < 100; i++) {
+        sselect.addFront(std::to_string(i));
+    }
+    assert(sselect.QuickSelect(1) == "0" && sselect.WCSelect(100) == "99");
+
+    // Batched order statistics and top-k
+    int ranks[] = {1000, 1, 2000, 500, 1000, 1999, 0, 1337};
+    std::vector<int> many = qcda.selectMany(ranks);
+    assert(many.size() == 8);
+    for (int i = 0; i < 8; i++) {
+        if (ranks[i] == 0) {
+            assert(many[i] == qcda.QuickSelect(0));
+        } else {
+            assert(many[i] == qsorted[ranks[i] - 1]);
+        }
+    }
+
+    std::vector<int> percentiles;
+    for (int p = 1; p <= 100; p++) {
+        percentiles.push_back(p * 1000);
+    }
+    std::vector<int> organQuantiles = organ.selectMany(percentiles, true);
+    for (int p = 1; p <= 100; p++) {
+        assert(organQuantiles[p - 1] == (p * 1000) / 2);
+    }
+
+    std::vector<int> smallest = qcda.topK(50);
+    assert(smallest.size() == 50);
+    for (int i = 0; i < 50; i++) {
+        assert(smallest[i] == qsorted[i]);
+    }
+    assert(qcda.topK(0).empty() && qcda.topK(5000).size() == 2000);
+
+    qcda.partialSort(10);
+    for (int i = 0; i < 10; i++) {
+        assert(qcda[i] == qsorted[i]);
+    }
+    for (int i = 10; i < 2000; i++) {
+        assert(!(qcda[i] < qcda[9]));
+    }
+
+    // Vectorized search, count and findAll on a wrapped array
+    CircularDynamicArray<int> fcda;
+    for (int i = 0; i < 1000; i++) {
+        fcda.addEnd(i % 17);
+    }
+    for (int i = 0; i < 300; i++) {
+        fcda.delFront();
+        fcda.addEnd(100 + i % 3);
+    }
+    assert(fcda.linearSearch(100) == 700);
+    assert(fcda.linearSearch(5) == 11);
+    assert(fcda.linearSearch(-3) == -1);
+    assert(fcda.count(101) == 100);
+    std::vector<int> fives = fcda.findAll(5);
+    assert((int)fives.size() == fcda.count(5));
+    for (int idx : fives) {
+        assert(fcda[idx] == 5);
+    }
+    assert(fcda.findIf([](int v) { return v > 100; }) == 701);
+    assert(fcda.findIf([](int v) { return v > 1000; }) == -1);
+
+    CircularDynamicArray<double> fdcda;
+    for (int i = 0; i < 100; i++) {
+        fdcda.addEnd(i * 0.5);
+    }
+    fdcda[77] = -0.0;
+    assert(fdcda.linearSearch(0.0) == 0 && fdcda.count(0.0) == 2 && fdcda.findAll(-0.0)[1] == 77);
+    assert(fdcda.linearSearch(std::numeric_limits<double>::quiet_NaN()) == -1);
+
+    assert(scda2.linearSearch("moved string") == 1 && scda2.count("xxx") == 2);
+
+    // Every kernel must agree with the scalar loop for every element size
+    std::int8_t bytes[100];
+    std::uint16_t shorts[100];
+    float floats[100];
+    long long longs[100];
+    for (int i = 0; i < 100; i++) {
+        bytes[i] = (std::int8_t)(i % 7);
+        shorts[i] = (std::uint16_t)(i % 11);
+        floats[i] = (float)(i % 13);
+        longs[i] = ((long long)(i % 5) << 32) | 3;
+    }
+    longs[50] = 3; // Matches the low half of every element
+
+    for (int n : {0, 5, 31, 64, 100}) {
+        auto check = [n](auto *arr, auto e) {
+            std::vector<int> expected, found;
+            SimdSearch::scanScalar(arr, n, e, SimdSearch::all, &expected, 0, 0);
+            int first = expected.empty() ? -1 : expected[0];
+            assert(SimdSearch::find(arr, n, e) == first);
+            assert(SimdSearch::countOf(arr, n, e) == (int)expected.size());
+            assert(SimdSearch::findAll(arr, n, e, found, 0) == (int)expected.size() && found == expected);
+#if DATASTRUCTS_X86_SIMD
+            found.clear();
+            assert(SimdSearch::scanSSE2(arr, n, e, SimdSearch::first, nullptr, 0) == first);
+            assert(SimdSearch::scanSSE2(arr, n, e, SimdSearch::all, &found, 0) == (int)expected.size() && found == expected);
+            if (__builtin_cpu_supports("avx2")) {
+                found.clear();
+                assert(SimdSearch::scanAVX2(arr, n, e, SimdSearch::first, nullptr, 0) == first);
+                assert(SimdSearch::scanAVX2(arr, n, e, SimdSearch::all, &found, 0) == (int)expected.size() && found == expected);
+            }
+#endif
+        };
+        check(bytes, (std::int8_t)6);
+        check(shorts, (std::uint16_t)10);
+        check(floats, 12.0f);
+        check(longs, 3LL);
+        check(longs, (4LL << 32) | 3);
+    }
+
+    // Branchless lowerBound and binSearch across the wrap point, with duplicates
+    {
+        CircularDynamicArray<int> scda;
+        for (int i = 20; i < 40; i++) {
+            scda.addEnd(2 * (i / 2));
+        }
+        for (int i = 19; i >= 0; i--) {
+            scda.addFront(2 * (i / 2));
+        }
+        assert(scda.segments().second.size() > 0);
+        for (int e = -1; e <= 40; e++) {
+            int expected = (int)(std::lower_bound(scda.begin(), scda.end(), e) - scda.begin());
+            assert(scda.lowerBound(e) == expected);
+            assert(scda.binSearch(e) == (e >= 0 && e < 40 && e % 2 == 0 ? e : -1));
+        }
+
+        CircularDynamicArray<int> ecda;
+        assert(ecda.lowerBound(3) == 0 && ecda.binSearch(3) == -1);
+    }
+
+    // Bulk trims, reserve, shrinkToFit and resize settings
+    {
+        CircularDynamicArray<int> bcda;
+        for (int i = 0; i < 1000; i++) {
+            bcda.addEnd(i);
+        }
+        for (int i = 0; i < 24; i++) {
+            bcda.addFront(-1 - i);
+        }
+        bcda.delFront(124);
+        assert(bcda.length() == 900 && bcda[0] == 100 && bcda[899] == 999);
+        bcda.delEnd(850);
+        assert(bcda.length() == 50 && bcda[49] == 149);
+        assert(bcda.capacity() == 128);
+        bcda.addEnd(150);
+        assert(bcda[50] == 150);
+        bcda.delEnd(1000);
+        assert(bcda.length() == 0 && bcda.capacity() == 2);
+        bcda.delFront(5);
+        bcda.addEnd(1);
+        bcda.addFront(0);
+        assert(bcda[0] == 0 && bcda[1] == 1);
+
+        // Trimming everything with start at 0 leaves the end in bounds
+        CircularDynamicArray<std::string> ecda;
+        ecda.addEnd("a");
+        ecda.addEnd("b");
+        ecda.delEnd(2);
+        ecda.addFront("c");
+        ecda.delEnd();
+        assert(ecda.length() == 0);
+        CircularDynamicArray<int> eicda;
+        eicda.addEnd(1);
+        eicda.delEnd(1);
+        eicda.addFront(2);
+        eicda.addEnd(3);
+        assert(eicda.length() == 2 && eicda[0] == 2 && eicda[1] == 3);
+
+        bcda.reserve(1000);
+        assert(bcda.capacity() == 1000);
+        for (int i = 0; i < 998; i++) {
+            bcda.addEnd(i);
+        }
+        assert(bcda.capacity() == 1000);
+        bcda.delFront(990);
+        assert(bcda.capacity() == 1000 && bcda.length() == 10);
+        bcda.shrinkToFit();
+        assert(bcda.capacity() == 10 && bcda[0] == 988 && bcda[9] == 997);
+
+        // Oscillating around the shrink threshold resizes once, then never again
+        CircularDynamicArray<int> ocda;
+        for (int i = 0; i < 64; i++) {
+            ocda.addEnd(i);
+        }
+        ocda.delFront(49);
+        assert(ocda.capacity() == 32);
+        for (int r = 0; r < 100; r++) {
+            for (int i = 0; i < 4; i++) {
+                ocda.addEnd(i);
+            }
+            ocda.delFront(4);
+            ocda.delFront();
+            ocda.addEnd(r);
+            assert(ocda.capacity() == 32 && ocda.length() == 15);
+        }
+
+        CircularDynamicArray<int> gcda;
+        gcda.setGrowthFactor(1.5);
+        gcda.setShrinkThreshold(0);
+        for (int i = 0; i < 10; i++) {
+            gcda.addEnd(i);
+        }
+        assert(gcda.capacity() == 13);
+        gcda.delFront(10);
+        assert(gcda.capacity() == 13);
+        gcda.setShrinkThreshold(0.5);
+        gcda.addEnd(1);
+        gcda.delEnd();
+        assert(gcda.capacity() == 2);
+
+        CircularDynamicArray<Tracked> tcda;
+        for (int i = 0; i < 40; i++) {
+            tcda.addEnd(i);
+        }
+        tcda.delFront(30);
+        tcda.delEnd(5);
+        assert(Tracked::live == 6 && tcda.length() == 5 && tcda[0].v == 30 && tcda[4].v == 34);
+    }
+
+    // Inline storage
+    {
+        using SmallInts = CircularDynamicArray<int, ModuloCapacity, CountingAllocator<int>, 16>;
+        SmallInts small;
+        assert(small.capacity() == 16);
+        for (int i = 0; i < 8; i++) {
+            small.addEnd(i);
+            small.addFront(-1 - i);
+        }
+        assert(small.length() == 16 && small[0] == -8 && small[15] == 7);
+        assert(small.QuickSelect(1, true) == -8); // Linearizes within the inline buffer
+        small.clear();
+        assert(small.capacity() == 16);
+        assert(allocations == 0);
+
+        for (int i = 0; i < 17; i++) {
+            small.addEnd(i);
+        }
+        assert(allocations == 1 && small.capacity() == 32);
+        small.delFront(10);
+        assert(deallocations == 1 && small.capacity() == 16);
+        assert(small[0] == 10 && small[6] == 16);
+
+        SmallInts copy(small);
+        SmallInts moved(std::move(copy));
+        assert(copy.length() == 0 && moved.length() == 7 && moved[6] == 16);
+        moved.stableSort();
+        moved.shrinkToFit();
+        assert(moved.capacity() == 16);
+
+        SmallInts big;
+        big.reserve(100);
+        big.addEnd(5);
+        big = std::move(moved);
+        assert(big.length() == 7 && big[0] == 10 && big.capacity() == 16);
+
+        CircularDynamicArray<int, PowerOfTwoCapacity, CountingAllocator<int>, 12> psmall;
+        assert(psmall.capacity() == 8);
+
+        int before = Tracked::live;
+        {
+            SmallCircularDynamicArray<Tracked, 4> tsmall;
+            for (int i = 0; i < 3; i++) {
+                tsmall.emplaceEnd(i);
+            }
+            tsmall.emplaceFront(9);
+            SmallCircularDynamicArray<Tracked, 4> tmoved(std::move(tsmall));
+            assert(tsmall.length() == 0 && tmoved.length() == 4 && tmoved[0].v == 9 && tmoved[3].v == 2);
+            tmoved.emplaceEnd(10);
+            assert(tmoved.capacity() == 8 && tmoved[4].v == 10);
+            tmoved.delEnd(4);
+            assert(tmoved.capacity() == 4 && tmoved.length() == 1 && tmoved[0].v == 9);
+        }
+        assert(Tracked::live == before);
+
+        SmallCircularDynamicArray<std::string, 8> words;
+        for (const char *w : {"delta", "alpha", "echo"}) {
+            words.addEnd(w);
+        }
+        words.addFront("charlie");
+        words.addFront("bravo");
+        words.stableSort();
+        assert(words[0] == "alpha" && words[4] == "echo");
+    }
+    assert(allocations == deallocations);
+
     return 0;
 }
\ No newline at end of file
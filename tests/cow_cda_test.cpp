@@ -0,0 +1,113 @@
+#include "../datastructs.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main() {
+    // Small chunks so the tests cross many chunk boundaries
+    CowCircularDynamicArray<int, 2> cow;
+    assert(cow.length() == 0 && cow.at(0) == 0);
+    cow.delFront();
+    cow.delEnd();
+
+    for (int i = 0; i < 10; i++) {
+        cow.addEnd(i);
+    }
+    for (int i = 1; i <= 10; i++) {
+        cow.addFront(-i);
+    }
+    assert(cow.length() == 20);
+    for (int i = 0; i < 20; i++) {
+        assert(cow.at(i) == i - 10);
+    }
+    assert(!cow.isShared());
+
+    // A snapshot shares everything until a write
+    CowCircularDynamicArray<int, 2> snap = cow.snapshot();
+    assert(cow.isShared() && snap.isShared());
+    cow[5] = 100;
+    cow.addEnd(10);
+    cow.delFront();
+    assert(snap.length() == 20 && snap.at(5) == -5 && snap.at(0) == -10);
+    assert(cow.length() == 20 && cow.at(4) == 100 && cow.at(19) == 10);
+    assert(!cow.isShared());
+
+    // Writing to the snapshot leaves the original alone
+    snap[0] = 7;
+    assert(snap.at(0) == 7 && cow.at(0) == -9);
+
+    // Drain from both ends, across chunk boundaries
+    CowCircularDynamicArray<int, 2> snap2(cow);
+    while (cow.length() > 4) {
+        cow.delFront();
+        cow.delEnd();
+    }
+    assert(cow.at(0) == -1 && cow.at(3) == 2);
+    assert(snap2.length() == 20 && snap2.at(19) == 10);
+    while (cow.length() > 0) {
+        cow.delEnd();
+    }
+    cow.addFront(1);
+    cow.addEnd(2);
+    assert(cow.length() == 2 && cow.at(0) == 1 && cow.at(1) == 2);
+
+    std::vector<int> seen;
+    snap2.forEach([&](const int &v) { seen.push_back(v); });
+    assert((int)seen.size() == 20 && seen[0] == -9 && seen[4] == 100 && seen[19] == 10);
+
+    cow.clear();
+    assert(cow.length() == 0 && snap2.length() == 20);
+    assert(cow[3] == 0);
+
+    // Non-trivial elements
+    CowCircularDynamicArray<std::string, 3> words;
+    for (int i = 0; i < 20; i++) {
+        words.addEnd(std::string(20, (char)('a' + i)));
+    }
+    auto before = words.snapshot();
+    words[0] += "!";
+    assert(words.at(0).back() == '!' && before.at(0).back() == 'a');
+
+    // A reader thread walks a snapshot while the owner keeps writing
+    CowCircularDynamicArray<long long> big;
+    for (int i = 0; i < 100000; i++) {
+        big.addEnd(i);
+    }
+    auto view = big.snapshot();
+    long long sum = 0;
+    std::thread reader([&] { view.forEach([&](const long long &v) { sum += v; }); });
+    for (int i = 0; i < 100000; i += 7) {
+        big[i] = -1;
+        big.addEnd(i);
+        big.delFront();
+    }
+    reader.join();
+    assert(sum == 100000LL * 99999 / 2);
+
+    // The reader releases its snapshot while the owner writes; writes made after the release may be done in place
+    CowCircularDynamicArray<long long> owned;
+    for (int i = 0; i < 5000; i++) {
+        owned.addEnd(i);
+    }
+    auto released = owned.snapshot();
+    std::atomic<bool> done = false;
+    long long releasedSum = 0;
+    std::thread releaser([&] {
+        CowCircularDynamicArray<long long> local = std::move(released);
+        local.forEach([&](const long long &v) { releasedSum += v; });
+        local = CowCircularDynamicArray<long long>();
+        done.store(true, std::memory_order_relaxed);
+    });
+    for (int r = 0; !done.load(std::memory_order_relaxed) || r < 100; r++) {
+        for (int i = 0; i < 5000; i += 97) {
+            owned[i] = r;
+        }
+    }
+    releaser.join();
+    assert(releasedSum == 5000LL * 4999 / 2 && !owned.isShared());
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "../datastructs.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <vector>
+
+int main() {
+    // Every size up to a few full levels, including the empty index
+    for (int n = 0; n <= 70; n++) {
+        std::vector<int> sorted(n);
+        for (int i = 0; i < n; i++) {
+            sorted[i] = 2 * (i / 3);
+        }
+        EytzingerIndex<int> index(sorted);
+        assert(index.length() == n);
+        for (int e = -1; e <= 2 * (n / 3) + 2; e++) {
+            int expected = (int)(std::lower_bound(sorted.begin(), sorted.end(), e) - sorted.begin());
+            assert(index.lowerBound(e) == expected);
+            bool present = expected < n && sorted[expected] == e;
+            assert(index.find(e) == (present ? expected : -1));
+            assert(index.contains(e) == present);
+        }
+    }
+
+    // Built from a circular dynamic array that wraps, indices match the array
+    CircularDynamicArray<int> cda;
+    for (int i = 50; i < 100; i++) {
+        cda.addEnd(i * 10);
+    }
+    for (int i = 49; i >= 0; i--) {
+        cda.addFront(i * 10);
+    }
+    EytzingerIndex<int> cindex(cda);
+    assert(cindex.length() == 100);
+    for (int i = 0; i < 100; i++) {
+        assert(cindex.find(i * 10) == i);
+        assert(cda[cindex.lowerBound(i * 10 - 5)] == i * 10);
+    }
+    assert(cindex.find(5) == -1);
+    assert(cindex.lowerBound(2000) == 100);
+
+    // Power-of-two policy and non-trivial elements
+    CircularDynamicArray<std::string, PowerOfTwoCapacity> words;
+    for (const char *w : {"delta", "echo", "foxtrot"}) {
+        words.addEnd(w);
+    }
+    for (const char *w : {"charlie", "bravo", "alpha"}) {
+        words.addFront(w);
+    }
+    EytzingerIndex<std::string> windex(words);
+    assert(windex.find("alpha") == 0);
+    assert(windex.find("foxtrot") == 5);
+    assert(windex.find("golf") == -1);
+    assert(windex.lowerBound("cat") == 2);
+
+    return 0;
+}
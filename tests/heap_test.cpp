@@ -3,6 +3,11 @@
 #include <iostream>
 #include <cassert>
 #include <sstream>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <span>
+#include <vector>
 
 int main() {
 
@@ -41,6 +46,7 @@ int main() {
     }
 	assert(testingStream.str() == "1 2 3 4 5 6 7 8 9 10");
 	testingStream.str(""); // Clear the stream
+	assert(T2.size() == 10 && T2.peekKey() == 1); // The copy is deep
 
 	// Test assignment operator
 	Heap<int> T4 = T1;
@@ -52,5 +58,115 @@ int main() {
     }
 	assert(testingStream.str() == "2 3 4 5 6 7 8 9 10");
 
+	// Wider nodes and other orderings
+	int C[100];
+	for (int i = 0; i < 100; i++) {
+		C[i] = (i * 37) % 100;
+	}
+	Heap<int, 4> H4(C, 100);
+	Heap<int, 8> H8;
+	Heap<int, 4, std::greater<int>> Max4;
+	for (int i = 0; i < 100; i++) {
+		H8.insert(C[i]);
+		Max4.insert(C[i]);
+	}
+	assert(H4.size() == 100 && H8.size() == 100 && Max4.peekKey() == 99);
+	for (int i = 0; i < 100; i++) {
+		assert(H4.extractMin() == i);
+		assert(H8.extractMin() == i);
+		assert(Max4.extractMin() == 99 - i);
+	}
+	assert(H4.size() == 0 && H4.extractMin() == 0 && H4.peekKey() == 0);
+
+	// A comparator with state, and keys that are not trivially copyable
+	auto byLength = [](const std::string &a, const std::string &b) { return a.size() < b.size(); };
+	Heap<std::string, 2, decltype(byLength)> Words(byLength);
+	for (const char *w : {"ccc", "a", "eeeee", "bb", "dddd"}) {
+		Words.insert(w);
+	}
+	assert(Words.extractMin() == "a" && Words.extractMin() == "bb" && Words.size() == 3);
+
+	Heap<std::string, 8> Letters(A, 10);
+	assert(Letters.extractMin() == "A" && Letters.peekKey() == "B");
+
+	// Batch insertion: small batches sift up, large ones re-heapify the new keys and their ancestors
+	for (int first : {0, 3, 40, 100}) {
+		for (int m : {1, 5, 30, 250}) {
+			Heap<int, 4> Batch(C, first);
+			std::vector<int> keys;
+			for (int i = 0; i < m; i++) {
+				keys.push_back((i * 53 + first) % 97 - 20);
+			}
+			Batch.insertBatch(keys.begin(), keys.end());
+			keys.insert(keys.end(), C, C + first);
+			std::sort(keys.begin(), keys.end());
+			assert(Batch.size() == (int)keys.size());
+			for (int k : keys) {
+				assert(Batch.extractMin() == k);
+			}
+		}
+	}
+	Heap<int> Descending;
+	std::vector<int> down;
+	for (int i = 0; i < 1000; i++) {
+		down.push_back(1000 - i);
+	}
+	Descending.insertBatch(std::span<const int>(down.data(), 10));
+	Descending.insertBatch(std::span<const int>(down.data() + 10, 990));
+	for (int i = 1; i <= 1000; i++) {
+		assert(Descending.extractMin() == i);
+	}
+	std::istringstream numbers("5 3 9 1");
+	Heap<int, 2, std::greater<int>> FromStream;
+	FromStream.insertBatch(std::istream_iterator<int>(numbers), std::istream_iterator<int>());
+	assert(FromStream.size() == 4 && FromStream.peekKey() == 9);
+
+	// Bulk extraction
+	Heap<int, 4> Drain(C, 100);
+	std::vector<int> smallest = Drain.extractMinBatch(10);
+	assert(smallest.size() == 10 && smallest.front() == 0 && smallest.back() == 9);
+	assert(Drain.size() == 90 && Drain.peekKey() == 10);
+	assert(Drain.extractMinBatch(0).empty() && Drain.extractMinBatch(-3).empty());
+	std::vector<int> due = Drain.popUntil(25);
+	assert(due.size() == 15 && due.front() == 10 && due.back() == 24);
+	assert(Drain.peekKey() == 25 && Drain.popUntil(25).empty());
+	std::vector<int> rest = Drain.extractMinBatch(1000);
+	assert(rest.size() == 75 && rest.front() == 25 && rest.back() == 99);
+	assert(std::is_sorted(rest.begin(), rest.end()));
+	assert(Drain.size() == 0 && Drain.popUntil(5).empty());
+	Drain.insert(7);
+	assert(Drain.popUntil(100).size() == 1 && Drain.size() == 0);
+
+	// replaceMin swaps the root in a single sift
+	Heap<int> Replace;
+	assert(Replace.replaceMin(3) == 0 && Replace.size() == 1);
+	Replace.insert(1);
+	Replace.insert(5);
+	assert(Replace.replaceMin(4) == 1);
+	assert(Replace.extractMin() == 3 && Replace.extractMin() == 4 && Replace.extractMin() == 5);
+
+	// In-place heapsort on a caller's buffer
+	for (int n : {0, 1, 2, 7, 100, 1000}) {
+		std::vector<int> v, w;
+		for (int i = 0; i < n; i++) {
+			v.push_back((i * 7919) % 263 - 100);
+		}
+		w = v;
+		std::vector<int> expected = v;
+		std::sort(expected.begin(), expected.end());
+		Heap<int>::heapSort(v.data(), n);
+		Heap<int, 4>::heapSort(std::span<int>(w));
+		assert(v == expected && w == expected);
+	}
+	int D[100];
+	std::copy(C, C + 100, D);
+	Heap<int, 8, std::greater<int>>::heapSort(D, 100);
+	for (int i = 0; i < 100; i++) {
+		assert(D[i] == 99 - i);
+	}
+	std::string Words2[5] = {"ccc", "a", "eeeee", "bb", "dddd"};
+	Heap<std::string, 2, decltype(byLength)>::heapSort(Words2, 5, byLength);
+	assert(Words2[0] == "a" && Words2[2] == "ccc" && Words2[4] == "eeeee");
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "../datastructs.hpp"
+
+#include <iostream>
+#include <cassert>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+int main() {
+
+	int B[10] = {10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+
+	IndexedHeap<int> H;
+	std::ostringstream testingStream;
+	int handles[10];
+
+	// Inserts match the level order of Heap
+	for (int i = 0; i < 10; i++) {
+		handles[i] = H.insert(B[i]);
+		assert(handles[i] == i);
+	}
+	H.printKeys(testingStream);
+	assert(testingStream.str() == "1 2 5 4 3 9 6 10 7 8\n");
+	testingStream.str(""); // Clear the stream
+
+	assert(H.size() == 10);
+	assert(H.peekKey() == 1);
+	assert(H.peekHandle() == 9);
+	assert(H.key(handles[0]) == 10);
+	assert(H.contains(handles[3]));
+	assert(!H.contains(-1) && !H.contains(10));
+
+	// decreaseKey moves a key up and rejects increases
+	assert(H.decreaseKey(handles[0], 0) == 1);
+	assert(H.peekKey() == 0 && H.peekHandle() == handles[0]);
+	assert(H.decreaseKey(handles[1], 20) == 0);
+	assert(H.key(handles[1]) == 9);
+
+	// increaseKey moves a key down and rejects decreases
+	assert(H.increaseKey(handles[0], 15) == 1);
+	assert(H.peekKey() == 1);
+	assert(H.increaseKey(handles[0], 3) == 0);
+	assert(H.key(handles[0]) == 15);
+
+	// erase removes a key from the middle and releases its handle
+	assert(H.erase(handles[5]) == 1);
+	assert(!H.contains(handles[5]));
+	assert(H.erase(handles[5]) == 0);
+	assert(H.size() == 9);
+
+	// Released handles are reused
+	int h = H.insert(11);
+	assert(h == handles[5]);
+	assert(H.key(h) == 11);
+
+	// Extraction comes out sorted and releases handles
+	int expected[10] = {1, 2, 3, 4, 6, 7, 8, 9, 11, 15};
+	for (int i = 0; i < 10; i++) {
+		assert(H.extractMin() == expected[i]);
+	}
+	assert(H.size() == 0);
+	assert(H.extractMin() == 0);
+	assert(H.peekHandle() == -1);
+	assert(!H.contains(handles[0]));
+
+	// Random changes stay consistent with a brute force reference
+	IndexedHeap<int, 4> R;
+	std::vector<int> ref;
+	std::vector<int> live;
+	unsigned x = 7;
+	for (int step = 0; step < 20000; step++) {
+		x = x * 1664525u + 1013904223u;
+		int op = (x >> 8) % 5;
+		int k = (x >> 12) % 1000;
+		if (op <= 1 || live.empty()) {
+			int hr = R.insert(k);
+			if (hr >= (int)ref.size()) {
+				ref.resize(hr + 1, -1);
+			}
+			ref[hr] = k;
+			live.push_back(hr);
+			continue;
+		}
+		int idx = (x >> 4) % live.size();
+		int hr = live[idx];
+		if (op == 2) {
+			assert(R.decreaseKey(hr, k) == (k <= ref[hr] ? 1 : 0));
+			ref[hr] = std::min(ref[hr], k);
+		} else if (op == 3) {
+			assert(R.increaseKey(hr, k) == (k >= ref[hr] ? 1 : 0));
+			ref[hr] = std::max(ref[hr], k);
+		} else {
+			assert(R.erase(hr) == 1);
+			live[idx] = live.back();
+			live.pop_back();
+		}
+		int min = -1;
+		for (int l : live) {
+			min = (min == -1 || ref[l] < min) ? ref[l] : min;
+		}
+		assert(R.size() == (int)live.size());
+		assert(live.empty() || R.peekKey() == min);
+		assert(live.empty() || ref[R.peekHandle()] == min);
+	}
+
+	// Maximum heap with string keys
+	IndexedHeap<std::string, 2, std::greater<std::string>> S;
+	int a = S.insert("apple");
+	S.insert("pear");
+	int c = S.insert("fig");
+	assert(S.peekKey() == "pear");
+	assert(S.decreaseKey(a, "zucchini") == 1);
+	assert(S.peekKey() == "zucchini");
+	assert(S.increaseKey(a, "banana") == 1);
+	assert(S.erase(c) == 1);
+	assert(S.extractMin() == "pear");
+	assert(S.extractMin() == "banana");
+	assert(S.size() == 0);
+
+	std::cout << "All tests passed!" << std::endl;
+
+	return 0;
+}
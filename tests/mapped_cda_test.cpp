@@ -0,0 +1,123 @@
+#include "../datastructs.hpp"
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <vector>
+
+struct Record {
+    std::int64_t id;
+    double value;
+    char tag[8];
+};
+
+int main() {
+    std::string path = "mapped_cda_test.bin";
+    std::remove(path.c_str());
+
+    {
+        MappedCircularDynamicArray<int> mcda(path, 5);
+        assert(mcda.capacity() == 8 && mcda.length() == 0);
+        assert(mcda[0] == 0);
+
+        // Wrap around before growing so the grow has to move the head segment
+        for (int i = 0; i < 4; i++) {
+            mcda.addEnd(i);
+        }
+        for (int i = -1; i >= -4; i--) {
+            mcda.addFront(i);
+        }
+        assert(mcda.length() == 8 && mcda.capacity() == 8);
+        mcda.addEnd(4);
+        assert(mcda.capacity() == 16);
+        for (int i = 0; i < 9; i++) {
+            assert(mcda[i] == i - 4);
+        }
+
+        mcda.delFront();
+        mcda.delEnd();
+        assert(mcda.length() == 7 && mcda[0] == -3 && mcda[6] == 3);
+
+        // Aliasing through a full ring
+        while (mcda.length() < mcda.capacity()) {
+            mcda.addEnd(7);
+        }
+        mcda.addFront(mcda[3]);
+        assert(mcda[0] == 0 && mcda.capacity() == 32);
+
+        std::vector<int> more(100);
+        for (int i = 0; i < 100; i++) {
+            more[i] = 1000 + i;
+        }
+        mcda.appendRange(more);
+        assert(mcda.length() == 117 && mcda.capacity() == 128);
+        assert(mcda[17] == 1000 && mcda[116] == 1099);
+
+        auto [head, tail] = mcda.segments();
+        assert((int)(head.size() + tail.size()) == mcda.length());
+        mcda.sync();
+    }
+
+    // Reopening maps the same ring without touching the elements
+    {
+        MappedCircularDynamicArray<int> mcda(path);
+        assert(mcda.length() == 117 && mcda.capacity() == 128);
+        assert(mcda[0] == 0 && mcda[1] == -3 && mcda[116] == 1099);
+        mcda.clear();
+        assert(mcda.length() == 0 && mcda.capacity() == 128);
+        mcda.addFront(42);
+    }
+    {
+        MappedCircularDynamicArray<int> mcda(path);
+        assert(mcda.length() == 1 && mcda[0] == 42);
+    }
+
+    // A file written for another element type is rejected
+    bool threw = false;
+    try {
+        MappedCircularDynamicArray<Record> wrong(path);
+    } catch (const std::system_error &) {
+        threw = true;
+    }
+    assert(threw);
+
+    // A header whose capacity is outside the int range is rejected before its byte size is computed
+    {
+        std::FILE *f = std::fopen(path.c_str(), "r+b");
+        std::int64_t hugeCap = (std::int64_t)1 << 62;
+        std::fseek(f, 2 * sizeof(std::uint64_t), SEEK_SET);
+        std::fwrite(&hugeCap, sizeof(hugeCap), 1, f);
+        std::fclose(f);
+    }
+    int error = 0;
+    try {
+        MappedCircularDynamicArray<int> corrupt(path);
+    } catch (const std::system_error &e) {
+        error = e.code().value();
+    }
+    assert(error == EINVAL);
+    std::remove(path.c_str());
+
+    // Records survive a reopen
+    {
+        MappedCircularDynamicArray<Record> records(path);
+        for (int i = 0; i < 1000; i++) {
+            records.addEnd(Record{i, i * 0.5, "rec"});
+            if (i % 3 == 0) {
+                records.delFront();
+            }
+        }
+    }
+    {
+        MappedCircularDynamicArray<Record> records(path);
+        assert(records.length() == 666);
+        assert(records[0].id == 334 && records[665].id == 999 && records[665].value == 499.5);
+        assert(std::string(records[10].tag) == "rec");
+    }
+    std::remove(path.c_str());
+
+    return 0;
+}
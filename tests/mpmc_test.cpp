@@ -0,0 +1,80 @@
+#include "../datastructs.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main() {
+    MPMCRingBuffer<int> ring(6);
+    assert(ring.capacity() == 8);
+
+    int out = 0;
+    assert(!ring.delFront(out));
+
+    for (int lap = 0; lap < 3; lap++) {
+        for (int i = 0; i < 8; i++) {
+            assert(ring.addEnd(lap * 8 + i));
+        }
+        assert(!ring.addEnd(-1));
+        assert(ring.length() == 8);
+        for (int i = 0; i < 8; i++) {
+            assert(ring.delFront(out) && out == lap * 8 + i);
+        }
+        assert(!ring.delFront(out));
+    }
+
+    // Non-trivial elements, some left in the ring for the destructor
+    {
+        MPMCRingBuffer<std::string> sring(4);
+        sring.addEnd("alpha");
+        sring.emplaceEnd(2, 'b');
+        std::string sout;
+        assert(sring.delFront(sout) && sout == "alpha");
+        sring.addEnd(std::string("gamma"));
+        assert(sring.length() == 2);
+    }
+
+    // Four producers and four consumers, every value must arrive exactly once
+    const int producers = 4, consumers = 4, perProducer = 100000;
+    MPMCRingBuffer<int> shared(256);
+    std::vector<std::atomic<int>> seen(producers * perProducer);
+    std::atomic<int> received = 0;
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < perProducer;) {
+                if (shared.addEnd(p * perProducer + i)) {
+                    i++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&] {
+            int v;
+            while (received.load() < producers * perProducer) {
+                if (shared.delFront(v)) {
+                    seen[v]++;
+                    received++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    for (int i = 0; i < producers * perProducer; i++) {
+        assert(seen[i] == 1);
+    }
+    assert(shared.length() == 0);
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "../datastructs.hpp"
+
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <functional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main() {
+
+	MultiQueue<int> Q(1);
+	int k = -1;
+	assert(Q.shardCount() == 2);
+	assert(Q.size() == 0 && !Q.tryExtractMin(k) && k == -1);
+
+	// Every key comes out exactly once, and the queue reports empty afterwards
+	for (int i = 0; i < 1000; i++) {
+		Q.insert((i * 7919) % 1000);
+	}
+	assert(Q.size() == 1000);
+	std::vector<int> seen(1000, 0);
+	for (int i = 0; i < 1000; i++) {
+		assert(Q.tryExtractMin(k));
+		seen[k]++;
+	}
+	for (int s : seen) {
+		assert(s == 1);
+	}
+	assert(Q.size() == 0 && !Q.tryExtractMin(k));
+
+	// With few shards the removed keys stay close to the minimum
+	MultiQueue<int> Ranked(2, 2);
+	std::set<int> present;
+	for (int i = 0; i < 2000; i++) {
+		int key = (i * 7919) % 2000;
+		Ranked.insert(key);
+		present.insert(key);
+	}
+	long long totalError = 0;
+	for (int i = 0; i < 2000; i++) {
+		assert(Ranked.tryExtractMin(k));
+		totalError += std::distance(present.begin(), present.find(k));
+		present.erase(k);
+	}
+	assert(present.empty());
+	assert(totalError / 2000.0 < 8.0);
+
+	// A maximum queue with keys that are not trivially copyable
+	MultiQueue<std::string, std::greater<std::string>> Words(1, 1);
+	Words.insert("b");
+	Words.insert("c");
+	Words.insert("a");
+	std::string w;
+	int words = 0;
+	while (Words.tryExtractMin(w)) {
+		words++;
+	}
+	assert(words == 3 && Words.size() == 0);
+
+	// Concurrent producers and consumers: nothing is lost or duplicated
+	const int producers = 4, consumers = 4, perProducer = 20000;
+	MultiQueue<int> Shared(producers + consumers, 2);
+	std::vector<std::atomic<int>> counts(producers * perProducer);
+	std::atomic<int> removed = 0;
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; p++) {
+		threads.emplace_back([&, p] {
+			for (int i = 0; i < perProducer; i++) {
+				Shared.insert(p * perProducer + i);
+			}
+		});
+	}
+	for (int c = 0; c < consumers; c++) {
+		threads.emplace_back([&] {
+			int key;
+			while (removed.load() < producers * perProducer) {
+				if (Shared.tryExtractMin(key)) {
+					counts[key]++;
+					removed++;
+				}
+			}
+		});
+	}
+	for (std::thread &t : threads) {
+		t.join();
+	}
+	for (std::atomic<int> &c : counts) {
+		assert(c.load() == 1);
+	}
+	assert(Shared.size() == 0 && !Shared.tryExtractMin(k));
+
+	std::cout << "All tests passed!" << std::endl;
+
+	return 0;
+}
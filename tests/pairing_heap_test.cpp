@@ -0,0 +1,109 @@
+#include "../datastructs.hpp"
+
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main() {
+
+	int B[10] = {10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+
+	PairingHeap<int> P;
+	assert(P.size() == 0 && P.peekKey() == 0 && P.extractMin() == 0);
+
+	PairingHeap<int>::Handle handles[10];
+	for (int i = 0; i < 10; i++) {
+		handles[i] = P.insert(B[i]);
+	}
+	assert(P.size() == 10);
+	assert(P.peekKey() == 1);
+
+	// decreaseKey moves a key to the front and rejects increases
+	assert(P.decreaseKey(handles[0], 0) == 1);
+	assert(P.peekKey() == 0);
+	assert(P.decreaseKey(handles[1], 20) == 0);
+	assert(P.decreaseKey(handles[0], -1) == 1);
+
+	int expected[10] = {-1, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	for (int i = 0; i < 10; i++) {
+		assert(P.extractMin() == expected[i]);
+	}
+	assert(P.size() == 0);
+
+	// Freed nodes are reused and handles stay valid after extractions restructure the tree
+	for (int round = 0; round < 3; round++) {
+		std::vector<PairingHeap<int>::Handle> hs;
+		std::vector<int> ref;
+		for (int i = 0; i < 1000; i++) {
+			int k = (i * 7919 + round) % 1009;
+			hs.push_back(P.insert(k));
+			ref.push_back(k);
+		}
+		for (int i = 0; i < 1000; i += 3) {
+			ref[i] -= 500;
+			assert(P.decreaseKey(hs[i], ref[i]) == 1);
+		}
+		std::sort(ref.begin(), ref.end());
+		for (int i = 0; i < 500; i++) {
+			assert(P.extractMin() == ref[i]);
+		}
+		for (int i = 500; i < 1000; i++) {
+			assert(P.extractMin() == ref[i]);
+		}
+		assert(P.size() == 0);
+	}
+
+	// meld moves every key and keeps handles from both heaps valid
+	PairingHeap<int> A, C;
+	std::vector<PairingHeap<int>::Handle> fromC;
+	for (int i = 0; i < 100; i++) {
+		A.insert(2 * i);
+		fromC.push_back(C.insert(2 * i + 1));
+	}
+	A.meld(C);
+	assert(A.size() == 200 && C.size() == 0 && C.peekKey() == 0);
+	assert(A.decreaseKey(fromC[99], -5) == 1);
+	assert(A.extractMin() == -5);
+	for (int i = 0; i < 199; i++) {
+		assert(A.extractMin() == i);
+	}
+	assert(A.size() == 0);
+
+	// The emptied heap still works and melding into an empty heap or with itself is harmless
+	C.insert(3);
+	PairingHeap<int> Empty;
+	Empty.meld(C);
+	Empty.meld(Empty);
+	assert(Empty.size() == 1 && Empty.extractMin() == 3);
+
+	// Moves transfer the tree and the pool
+	PairingHeap<int> M;
+	for (int i = 0; i < 50; i++) {
+		M.insert(50 - i);
+	}
+	PairingHeap<int> N(std::move(M));
+	assert(M.size() == 0 && N.size() == 50 && N.peekKey() == 1);
+	M = std::move(N);
+	assert(M.size() == 50 && M.extractMin() == 1);
+
+	// Maximum heap with keys that are not trivially copyable; the destructor releases the rest
+	PairingHeap<std::string, std::greater<std::string>> S;
+	auto apple = S.insert("apple");
+	S.insert("pear");
+	S.insert("fig");
+	assert(S.peekKey() == "pear");
+	assert(S.decreaseKey(apple, "zucchini") == 1);
+	assert(S.extractMin() == "zucchini");
+	assert(S.extractMin() == "pear");
+	for (int i = 0; i < 300; i++) {
+		S.insert(std::string(40, (char)('a' + i % 26)));
+	}
+
+	std::cout << "All tests passed!" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,59 @@
+#include "../datastructs.hpp"
+
+#include <iostream>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main() {
+
+	int B[10] = {10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+
+	PayloadHeap<int, std::string> H;
+	assert(H.size() == 0 && H.peekKey() == 0 && H.peekPayload() == "");
+	assert(H.extractMin() == std::make_pair(0, std::string()));
+
+	for (int i = 0; i < 10; i++) {
+		H.insert(B[i], std::string(B[i], 'x'));
+	}
+	assert(H.size() == 10 && H.peekKey() == 1 && H.peekPayload() == "x");
+
+	// The payload stays attached to its key
+	H.peekPayload() = "one";
+	std::pair<int, std::string> min = H.extractMin();
+	assert(min.first == 1 && min.second == "one");
+	for (int k = 2; k <= 5; k++) {
+		min = H.extractMin();
+		assert(min.first == k && min.second == std::string(k, 'x'));
+	}
+
+	// Freed payload slots are reused
+	H.insert(0, "zero");
+	H.insert(3, "three");
+	assert(H.size() == 7 && H.peekPayload() == "zero");
+	std::vector<int> keys;
+	while (H.size() > 0) {
+		min = H.extractMin();
+		keys.push_back(min.first);
+		assert(min.first == 0 ? min.second == "zero" : min.first == 3 ? min.second == "three" : min.second == std::string(min.first, 'x'));
+	}
+	assert((keys == std::vector<int>{0, 3, 6, 7, 8, 9, 10}));
+
+	// Wider nodes, a maximum heap and payloads that can only be moved
+	PayloadHeap<int, std::unique_ptr<int>, 4, std::greater<int>> Max(std::greater<int>{});
+	for (int i = 0; i < 100; i++) {
+		int k = (i * 37) % 100;
+		Max.insert(k, std::make_unique<int>(k * 2));
+	}
+	for (int i = 99; i >= 0; i--) {
+		assert(*Max.peekPayload() == i * 2);
+		std::pair<int, std::unique_ptr<int>> top = Max.extractMin();
+		assert(top.first == i && *top.second == i * 2);
+	}
+	assert(Max.size() == 0 && Max.peekPayload() == nullptr);
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "../datastructs.hpp"
+
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+int main() {
+
+	RadixHeap<> R;
+	assert(R.size() == 0 && R.peekKey() == 0 && R.extractMin() == 0);
+
+	unsigned B[10] = {10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+	for (unsigned k : B) {
+		assert(R.insert(k));
+	}
+	assert(R.size() == 10 && R.peekKey() == 1);
+	for (unsigned i = 1; i <= 5; i++) {
+		assert(R.extractMin() == i);
+	}
+	assert(R.lastKey() == 5);
+
+	// Keys below the last extracted key are rejected; equal keys are fine
+	assert(!R.insert(4));
+	assert(R.insert(5) && R.insert(5));
+	assert(R.size() == 7);
+	assert(R.extractMin() == 5 && R.extractMin() == 5 && R.extractMin() == 6);
+	while (R.size() > 0) {
+		R.extractMin();
+	}
+	assert(R.lastKey() == 10);
+
+	// A monotone workload matches a sorted reference, across the whole key range
+	RadixHeap<std::uint64_t> Wide;
+	std::vector<std::uint64_t> pending;
+	std::uint64_t x = 1, now = 0;
+	for (int step = 0; step < 50000; step++) {
+		x = x * 6364136223846793005ull + 1442695040888963407ull;
+		if (step % 3 != 2 || pending.empty()) {
+			std::uint64_t delta = (x >> 11) >> ((x >> 3) % 53);
+			if (now + delta < now) {
+				delta = 0;
+			}
+			assert(Wide.insert(now + delta));
+			pending.push_back(now + delta);
+			std::push_heap(pending.begin(), pending.end(), std::greater<std::uint64_t>());
+		} else {
+			std::pop_heap(pending.begin(), pending.end(), std::greater<std::uint64_t>());
+			std::uint64_t expected = pending.back();
+			pending.pop_back();
+			assert(Wide.peekKey() == expected);
+			now = Wide.extractMin();
+			assert(now == expected);
+		}
+		assert(Wide.size() == (int)pending.size());
+	}
+	assert(Wide.insert(std::numeric_limits<std::uint64_t>::max()));
+
+	// Small key types use fewer buckets
+	RadixHeap<std::uint8_t> Bytes;
+	for (int k = 255; k >= 0; k -= 5) {
+		Bytes.insert((std::uint8_t)k);
+	}
+	for (int k = 0; k <= 255; k += 5) {
+		assert(Bytes.extractMin() == k);
+	}
+	assert(Bytes.size() == 0);
+
+	std::cout << "All tests passed!" << std::endl;
+
+	return 0;
+}
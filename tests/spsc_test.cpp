@@ -0,0 +1,91 @@
+#include "../datastructs.hpp"
+
+#include <cassert>
+#include <string>
+#include <thread>
+
+int main() {
+    SPSCRingBuffer<int> ring(5);
+    assert(ring.capacity() == 8);
+    assert(ring.length() == 0);
+
+    int out = 0;
+    assert(!ring.delFront(out));
+
+    for (int i = 0; i < 8; i++) {
+        assert(ring.addEnd(i));
+    }
+    assert(!ring.addEnd(8));
+    assert(ring.length() == 8);
+
+    for (int i = 0; i < 5; i++) {
+        assert(ring.delFront(out) && out == i);
+    }
+
+    // Batches wrap around the physical end of the buffer
+    int batch[6] = {8, 9, 10, 11, 12, 13};
+    assert(ring.addEndBatch(batch, 6) == 5);
+    assert(ring.length() == 8);
+
+    int drained[10];
+    assert(ring.delFrontBatch(drained, 10) == 8);
+    for (int i = 0; i < 8; i++) {
+        assert(drained[i] == i + 5);
+    }
+    assert(ring.length() == 0);
+
+    // Empty and negative batches are ignored
+    assert(ring.addEndBatch(batch, 0) == 0 && ring.addEndBatch(batch, -3) == 0);
+    ring.addEnd(1);
+    assert(ring.delFrontBatch(drained, -1) == 0 && ring.length() == 1);
+    assert(ring.delFront(out) && out == 1);
+
+    // Non-trivial elements, some left in the ring for the destructor
+    {
+        SPSCRingBuffer<std::string> sring(4);
+        std::string words[3] = {"alpha", "beta", "gamma"};
+        assert(sring.addEndBatch(words, 3) == 3);
+        sring.emplaceEnd(3, 'z');
+        std::string sout;
+        assert(sring.delFront(sout) && sout == "alpha");
+        std::string sdrained[2];
+        assert(sring.delFrontBatch(sdrained, 2) == 2);
+        assert(sdrained[0] == "beta" && sdrained[1] == "gamma");
+        sring.addEnd("delta");
+    }
+
+    // One producer and one consumer thread, values must arrive in order
+    const int count = 1000000;
+    SPSCRingBuffer<int> shared(1024);
+    std::thread producer([&] {
+        int next = 0;
+        int chunk[64];
+        while (next < count) {
+            if (next % 3 == 0) {
+                if (shared.addEnd(next)) {
+                    next++;
+                }
+            } else {
+                int n = std::min(64, count - next);
+                for (int i = 0; i < n; i++) {
+                    chunk[i] = next + i;
+                }
+                next += shared.addEndBatch(chunk, n);
+            }
+        }
+    });
+
+    long long expected = 0;
+    int buffer[100];
+    while (expected < count) {
+        int n = shared.delFrontBatch(buffer, 100);
+        for (int i = 0; i < n; i++) {
+            assert(buffer[i] == expected);
+            expected++;
+        }
+    }
+    producer.join();
+    assert(shared.length() == 0);
+
+    return 0;
+}
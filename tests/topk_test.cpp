@@ -0,0 +1,72 @@
+#include "../datastructs.hpp"
+
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+int main() {
+
+	TopKTracker<int> T(5);
+	assert(T.capacity() == 5 && T.size() == 0 && T.threshold() == 0);
+	assert(T.sorted().empty());
+
+	// Fills up to K, then keeps only keys above the threshold
+	for (int v : {4, 9, 1, 7, 3}) {
+		assert(T.push(v));
+	}
+	assert(T.size() == 5 && T.threshold() == 1);
+	assert(!T.push(0) && !T.push(1));
+	assert(T.push(8));
+	assert(T.size() == 5 && T.threshold() == 3);
+	assert((T.sorted() == std::vector<int>{9, 8, 7, 4, 3}));
+	assert(T.size() == 5);
+
+	// A long stream keeps exactly the K largest keys
+	TopKTracker<int> Stream(100);
+	std::vector<int> all;
+	for (int i = 0; i < 100000; i++) {
+		int v = (int)(((long long)i * 7919) % 100003);
+		Stream.push(v);
+		all.push_back(v);
+	}
+	std::sort(all.rbegin(), all.rend());
+	all.resize(100);
+	assert(Stream.size() == 100 && Stream.sorted() == all);
+
+	// Per-thread trackers merge into the same result
+	TopKTracker<int> A(100), B(100);
+	for (int i = 0; i < 100000; i++) {
+		int v = (int)(((long long)i * 7919) % 100003);
+		(i % 2 ? A : B).push(v);
+	}
+	A.mergeFrom(B);
+	A.mergeFrom(A);
+	assert(A.sorted() == all);
+	assert(B.size() == 100);
+
+	// Duplicates are kept up to K
+	TopKTracker<int> Same(3);
+	for (int i = 0; i < 10; i++) {
+		Same.push(5);
+	}
+	assert((Same.sorted() == std::vector<int>{5, 5, 5}));
+
+	// std::greater keeps the K smallest; clear starts a new window
+	TopKTracker<std::string, std::greater<std::string>> Smallest(2);
+	for (const char *w : {"pear", "apple", "fig", "kiwi", "banana"}) {
+		Smallest.push(w);
+	}
+	assert((Smallest.sorted() == std::vector<std::string>{"apple", "banana"}));
+	assert(Smallest.threshold() == "banana");
+	Smallest.clear();
+	assert(Smallest.size() == 0);
+	Smallest.push("zebra");
+	assert(Smallest.threshold() == "zebra");
+
+	std::cout << "All tests passed!" << std::endl;
+
+	return 0;
+}